@@ -1,19 +1,45 @@
 #include "../src/aircraft.h"
+#include "../src/cancel.h"
 #include "../src/map.h"
-#include "../src/router1.h"
+#include "../src/planner.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
 
 /*
  Running this code will give a demonstration of the router.
+
+ Usage: ./RouterDemo [planner] [searchPercentage] [moveLimit] [seconds]
+        ./RouterDemo --list
+ The planner defaults to "greedy", the original RoutePlanner. Given a number
+ of seconds, planning stops at that deadline and the partial route is shown.
  */
-int main() {
+int main(int argc, char *argv[]) {
+  const std::string name = argc > 1 ? argv[1] : "greedy";
+  if (name == "--list") {
+    for (const std::string &planner : getPlannerNames()) {
+      std::cout << planner << ": " << getPlannerDescription(planner) << "\n";
+    }
+    return 0;
+  }
+  const float searchPercentage = argc > 2 ? std::atof(argv[2]) : 0.8;
+  const int moveLimit = argc > 3 ? std::atoi(argv[3]) : 1000000;
+  const CancelToken token =
+      argc > 4 ? CancelToken(std::atof(argv[4])) : CancelToken();
+
   GridMap map(100, "../unit_tests/test_csv/bigTestGrid.csv");
   map.mapStats();
 
   Aircraft aircraft(0, Direction::dir_EAST, 0, map);
 
-  RoutePlanner router(aircraft);
+  const PlanResult result = planRoute(name, map, aircraft.getState(),
+                                      searchPercentage, moveLimit, token);
 
-  router.findRoute();
+  std::cout << "Planner " << name << ": " << result.moves.size()
+            << " moves, " << result.coverage * 100 << "% coverage, "
+            << (result.targetMet ? "target met" : "target missed")
+            << (result.interrupted ? " (stopped at the deadline)" : "") << ", "
+            << result.planSeconds << " s\n";
 
   return 0;
 }
@@ -1,4 +1,4 @@
 # make script executable via "chmod +x compile.sh"
 
-g++ -std=c++11 -O3 -o RouterDemo RouterDemo.cpp ../src/aircraft.cpp ../src/router1.cpp ../src/map.cpp
-g++ -std=c++11 -O3 -o FloodFillDemo FloodFillDemo.cpp ../src/aircraft.cpp ../src/router1.cpp ../src/map.cpp
+g++ -std=c++14 -O3 -o RouterDemo RouterDemo.cpp ../src/aircraft.cpp ../src/router1.cpp ../src/beamsearch.cpp ../src/boustrophedon.cpp ../src/dstarlite.cpp ../src/fleet.cpp ../src/landmarks.cpp ../src/map.cpp ../src/optimizer.cpp ../src/orienteering.cpp ../src/partition.cpp ../src/pathfinder.cpp ../src/planner.cpp ../src/portfolio.cpp ../src/replanner.cpp ../src/replay.cpp ../src/roadmap.cpp ../src/routebuilder.cpp ../src/search.cpp ../src/spanningtree.cpp ../src/threadpool.cpp ../src/tour.cpp ../src/traps.cpp -pthread
+g++ -std=c++14 -O3 -o FloodFillDemo FloodFillDemo.cpp ../src/aircraft.cpp ../src/router1.cpp ../src/beamsearch.cpp ../src/boustrophedon.cpp ../src/dstarlite.cpp ../src/fleet.cpp ../src/landmarks.cpp ../src/map.cpp ../src/optimizer.cpp ../src/orienteering.cpp ../src/partition.cpp ../src/pathfinder.cpp ../src/planner.cpp ../src/portfolio.cpp ../src/replanner.cpp ../src/replay.cpp ../src/roadmap.cpp ../src/routebuilder.cpp ../src/search.cpp ../src/spanningtree.cpp ../src/threadpool.cpp ../src/tour.cpp ../src/traps.cpp -pthread
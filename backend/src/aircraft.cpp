@@ -1,166 +1,13 @@
 #include "aircraft.h"
 #include "map.h"
+#include "state.h"
+#include "workspace.h"
 #include <array>
-#include <cassert>
 #include <iostream>
-#include <queue>
 #include <vector>
 
 namespace {
 
-/*
- * @brief Helper function for Aircraft's moveForward(), verifying position for
- * forward moves.
- *
- * @param aircraft The aircraft with position being validated.
- * @param map The map the aircraft uses.
- *
- * @return true if moving forward keeps the aircraft on the map, else false.
- */
-bool forwardPositionValid(Aircraft &aircraft, GridMap &map) {
-
-  switch (aircraft.getDir()) {
-
-  case Direction::dir_NORTH:
-    // The row position must be > 0
-    if (aircraft.getCurRow() <= 0) {
-      std::cerr << "Error: attempted to move NORTH, but currently at row "
-                << aircraft.getCurRow() << std::endl;
-      return false;
-    }
-
-    return true;
-
-  case Direction::dir_SOUTH:
-    // The row position must be < GridMap's m_rowCount - 1
-    if (aircraft.getCurRow() >= map.getRowCount() - 1) {
-      std::cerr << "Error: attempted to move SOUTH, but currently at row "
-                << aircraft.getCurRow() << " and map only contains "
-                << map.getRowCount() - 1 << " rows.\n";
-      return false;
-    }
-
-    return true;
-
-  case Direction::dir_EAST:
-    // The column position must be < GridMap's m_colCount - 1
-    if (aircraft.getCurCol() >= map.getColCount() - 1) {
-      std::cerr << "Error: attempted to move EAST, but currently at column "
-                << aircraft.getCurCol() << " and map only contains "
-                << map.getColCount() - 1 << " columns.\n";
-      return false;
-    }
-
-    return true;
-
-  case Direction::dir_WEST:
-    // The column position must be > 0
-    if (aircraft.getCurCol() <= 0) {
-      std::cerr << "Error: attempted to move WEST, but currently at column "
-                << aircraft.getCurCol() << std::endl;
-      return false;
-    }
-
-    return true;
-  }
-
-  std::cerr << "Error: Something bad happened. Is the aircraft direction not a "
-               "valid direction?\n";
-  return false;
-}
-
-/*
- * @brief Helper function for Aircraft's moveForward(), verifying traversability
- * for forward moves.
- *
- * @param aircraft The aircraft with position being validated.
- * @param map The map the aircraft uses.
- *
- * @return true if moving forward lands on traversable Cell, else false.
- */
-bool forwardTraverabilityValid(Aircraft &aircraft, GridMap &map) {
-  switch (aircraft.getDir()) {
-  case Direction::dir_NORTH:
-    // The cell one row above the aircarft must be traversable
-    if (map.isTraversable(aircraft.getCurRow() - 1, aircraft.getCurCol())) {
-      return true;
-    }
-
-    std::cerr << "Error: moving NORTH lands on untraversable Cell\n";
-    return false;
-
-  case Direction::dir_SOUTH:
-    // The Cell one row below the aircraft must be traversable
-    if (map.isTraversable(aircraft.getCurRow() + 1, aircraft.getCurCol())) {
-      return true;
-    }
-
-    std::cerr << "Error: moving SOUTH lands on untraverable Cell\n";
-    return false;
-
-  case Direction::dir_EAST:
-    // The Cell one column right of the aircraft must be traversable
-    if (map.isTraversable(aircraft.getCurRow(), aircraft.getCurCol() + 1)) {
-      return true;
-    }
-
-    std::cerr << "Error: moving EAST lands on untraversable Cell\n";
-    return false;
-
-  case Direction::dir_WEST:
-    // The Cell one column left of the aircraft must be traversable
-    if (map.isTraversable(aircraft.getCurRow(), aircraft.getCurCol() - 1)) {
-      return true;
-    }
-
-    std::cerr << "Error: moving WEST lands on untraverable Cell\n";
-    return false;
-  }
-
-  std::cerr << "Error: Something bad happened. Is the aircraft direction not a "
-               "valid direction?\n";
-  return false;
-}
-
-/*
- *
- * @brief Helper funtion for scan(). Scans Cells in a range of rows and columns
- * determined by scan().
- *
- * @note As they are sacnned, the rows and columns count UPWARD.
- *
- * @param startRow The row from the aircraft's position to start scanning at.
- * @param startCol The column from the aircraft's position to start scanning at.
- * @param endRow The row from the aircraft's position to end scanning at.
- * @param endCol The column from the aircraft's position to end scanning at.
- * @param aircraft The aircraft whose scanner is being used.
- * @param map The GridMap the aircraft exists on.
- *
- * @return Number of new traversable Cells scanned.
- */
-int scanCells(const int startRow, const int startCol, const int endRow,
-              const int endCol, const Aircraft aircraft, GridMap &map) {
-  int newScanCount = 0;
-  // For every row in the scanning range...
-  for (int scanRow = aircraft.getCurRow() + startRow;
-       scanRow <= endRow + aircraft.getCurRow(); scanRow++) {
-    // For every column in the scanning range...
-    for (int scanCol = aircraft.getCurCol() + startCol;
-         scanCol <= endCol + aircraft.getCurCol(); scanCol++) {
-      // If the Cell loctation is on the map...
-      if (scanRow >= 0 && scanCol >= 0 && scanRow < map.getRowCount() &&
-          scanCol < map.getColCount() && !map.isScanned(scanRow, scanCol)) {
-        if (map.isTraversable(scanRow, scanCol)) {
-          // Mark it as scanned
-          map.markScanned(scanRow, scanCol);
-          newScanCount++;
-        }
-      }
-    }
-  }
-  return newScanCount;
-}
-
 /*
  * @brief 2D array BFS that searches for the closest traversable Cell from an
  * arbitrary point and changes Aircraft location to that Cell.
@@ -168,53 +15,47 @@ int scanCells(const int startRow, const int startCol, const int endRow,
  * @param startRow The row to start BFS at.
  * @param startCol The column to start BFS at.
  * @param map The GridMap being searched.
+ * @param workspace The reusable BFS buffers.
  *
  * @return Nothing.
  */
-void closestTraversableBFS(Aircraft &aircraft, const GridMap &map) {
-  struct BFSCell {
-    int row;
-    int col;
-  };
-
-  const int rows = map.getRowCount();
+void closestTraversableBFS(Aircraft &aircraft, const GridMap &map,
+                           SearchWorkspace &workspace) {
   const int cols = map.getColCount();
 
-  // visited matrix ensures each Cell is visited only once
-  std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-
-  // BFS queue
-  std::queue<BFSCell> q;
-  q.push({aircraft.getCurRow(), aircraft.getCurCol()});
-  visited[aircraft.getCurRow()][aircraft.getCurCol()] = true;
+  // Cells are numbered row * cols + col; the workspace tracks visited Cells
+  // and holds the BFS queue
+  workspace.begin(map.getRowCount() * cols);
+  workspace.push(aircraft.getCurRow() * cols + aircraft.getCurCol());
 
   // Directions for movement (up, down, left, and right)
   std::array<int, 4> dRow = {0, 0, -1, 1};
   std::array<int, 4> dCol = {-1, 1, 0, 0};
 
-  while (!q.empty()) {
-    const BFSCell curr = q.front();
-    q.pop();
+  while (!workspace.frontierEmpty()) {
+    const int curr = workspace.pop();
+    const int currRow = curr / cols;
+    const int currCol = curr % cols;
 
     // Check if current Cell is traversable
-    if (map.isTraversable(curr.row, curr.col)) {
+    if (map.isTraversable(currRow, currCol)) {
       std::cerr << "Aircraft starting position changed to the cloesest "
                    "traversable Cell ["
-                << curr.row << "][" << curr.col << "]\n";
-      aircraft.setRow(curr.row);
-      aircraft.setCol(curr.col);
+                << currRow << "][" << currCol << "]\n";
+      aircraft.setRow(currRow);
+      aircraft.setCol(currCol);
       return;
     }
 
     // If not, explore the neighboring Cells
     for (int i = 0; i < 4; i++) {
-      const int newRow = curr.row + dRow[i];
-      const int newCol = curr.col + dCol[i];
+      const int newRow = currRow + dRow[i];
+      const int newCol = currCol + dCol[i];
 
       // Ensure new Cell is within bounds and not yet visited
-      if (map.isWithinBounds(newRow, newCol) && !visited[newRow][newCol]) {
-        visited[newRow][newCol] = true;
-        q.push({newRow, newCol});
+      if (map.isWithinBounds(newRow, newCol) &&
+          !workspace.isVisited(newRow * cols + newCol)) {
+        workspace.push(newRow * cols + newCol);
       }
     }
   }
@@ -225,162 +66,65 @@ void closestTraversableBFS(Aircraft &aircraft, const GridMap &map) {
 } // namespace
 
 Aircraft::Aircraft(int startRow, Direction startDir, int startCol, GridMap map)
-    : m_curRow(startRow), m_curCol(startCol), m_dir(startDir), m_map(map) {
+    : m_state(makeState(startRow, startCol, startDir)), m_map(map) {
   // Enforce a valid starting position
   if (!map.isTraversable(startRow, startCol)) {
     std::cerr << "Starting position at [" << startRow << "][" << startCol
               << "] is untraversable. A new position must be found.\n";
-    closestTraversableBFS(*this, map);
+    SearchWorkspace workspace;
+    closestTraversableBFS(*this, map, workspace);
   }
 }
-void Aircraft::moveForward() {
-  // For each direcion, determine if moving forward is a valid move and the
-  // space is traversable, if not throw an exception, if it is, move forward
-  switch (m_dir) {
-
-  case Direction::dir_NORTH:
-    if (forwardPositionValid(*this, m_map) &&
-        forwardTraverabilityValid(*this, m_map)) {
-      // Move NORTH by decreasing row position
-      m_curRow--;
-    } else {
-      // Tried to move to invalid spot, throw exception
-      throw std::exception();
-      return;
-    }
-    break;
 
-  case Direction::dir_SOUTH:
-    if (forwardPositionValid(*this, m_map) &&
-        forwardTraverabilityValid(*this, m_map)) {
-      // Move SOUTH by increasing row position
-      m_curRow++;
-    } else {
-      // Tried to move to invalid spot, throw exception
-      throw std::exception();
-      return;
-    }
-    break;
-
-  case Direction::dir_EAST:
-    if (forwardPositionValid(*this, m_map) &&
-        forwardTraverabilityValid(*this, m_map)) {
-      // Move EAST by increasing column position
-      m_curCol++;
-    } else {
-      // Tried to move to invalid spot, throw exception
-      throw std::exception();
-      return;
-    }
-    break;
+void Aircraft::moveForward() {
+  // The shared transition determines if moving forward stays on the map and
+  // lands on a traversable Cell. If not, throw an exception
+  AircraftState next{};
+  if (!step(m_state, Moves::move_FORWARD, m_map, next)) {
+    std::cerr << "Error: attempted to move " << m_state.dir << " from ["
+              << m_state.row << "][" << m_state.col
+              << "], which leaves the map or lands on an untraversable "
+                 "Cell\n";
+    throw std::exception();
+  }
+  m_state = next;
+}
 
-  case Direction::dir_WEST:
-    if (forwardPositionValid(*this, m_map) &&
-        forwardTraverabilityValid(*this, m_map)) {
-      // Move WEST by increasing column position
-      m_curCol--;
-    } else {
-      // tried to move to invalid spot, throw exception
-      throw std::exception();
-      return;
-    }
-    break;
+int Aircraft::forward(int steps) {
+  if (steps <= 0) {
+    return 0;
   }
+  // Every Cell along the run must be on the map and traversable
+  if (::forwardRunLength(m_map, m_state, steps) < steps) {
+    std::cerr << "Error: attempted to move " << m_state.dir << " " << steps
+              << " Cells from [" << m_state.row << "][" << m_state.col
+              << "], which leaves the map or crosses an untraversable Cell\n";
+    throw std::exception();
+  }
+  const std::array<int, 4> area = sweptFootprint(m_state, steps);
+  m_state = advancedBy(m_state, steps);
+  return m_map.scanArea(area[0], area[1], area[2], area[3]);
+}
 
-  assert(m_curRow > -1 && m_curRow < m_map.getRowCount());
-  assert(m_curCol > -1 && m_curCol < m_map.getColCount());
+int Aircraft::forwardRunLength(int limit) const {
+  return ::forwardRunLength(m_map, m_state, limit);
 }
 
 void Aircraft::turnLeft() {
-  // North --> West
-  // South --> East
-  // East --> North
-  // West --> South
-
-  switch (m_dir) {
-
-  case Direction::dir_NORTH:
-    m_dir = Direction::dir_WEST;
-    return;
-
-  case Direction::dir_SOUTH:
-    m_dir = Direction::dir_EAST;
-    return;
-
-  case Direction::dir_EAST:
-    m_dir = Direction::dir_NORTH;
-    return;
-
-  case Direction::dir_WEST:
-    m_dir = Direction::dir_SOUTH;
-    return;
-  }
+  m_state = applyMove(m_state, Moves::move_TURNLEFT);
 }
 
 void Aircraft::turnRight() {
-  // North --> East
-  // South --> West
-  // East --> South
-  // West --> North
-
-  switch (m_dir) {
-
-  case Direction::dir_NORTH:
-    m_dir = Direction::dir_EAST;
-    return;
-
-  case Direction::dir_SOUTH:
-    m_dir = Direction::dir_WEST;
-    return;
-
-  case Direction::dir_EAST:
-    m_dir = Direction::dir_SOUTH;
-    return;
-
-  case Direction::dir_WEST:
-    m_dir = Direction::dir_NORTH;
-    return;
-  }
+  m_state = applyMove(m_state, Moves::move_TURNRIGHT);
 }
 
 int Aircraft::scan() {
-  int newScanCount = 0;
-
-  // Determine the direction of the aircraft
-  switch (m_dir) {
-
-  // For each direction, if the cell exists, scan an area two rows ahead and
-  // three rows wide
-  case Direction::dir_NORTH:
-    // For NORTH, scan Cells in rows -1, -2; columns -1, 0, 1 from the
-    // aircraft
-    assert(m_curRow - 1 < m_map.getRowCount() - 1);
-    newScanCount = scanCells(-2, -1, -1, 1, *this, m_map);
-
-    return newScanCount;
-
-  case Direction::dir_SOUTH:
-    // For SOUTH, scan Cells in rows 1, 2; columns -1, 0, 1 from the aircraft
-    assert(m_curRow + 1 > 0);
-    newScanCount = scanCells(1, -1, 2, 1, *this, m_map);
-
-    return newScanCount;
-
-  case Direction::dir_EAST:
-    // For EAST, scan Cells in rows -1, 0, 1; columns 1, 2 from the aircraft
-    assert(m_curCol + 1 > 0);
-    newScanCount = scanCells(-1, 1, 1, 2, *this, m_map);
-
-    return newScanCount;
-
-  case Direction::dir_WEST:
-    // For WEST, scan Cells in rows -1, 0, 1; columns -1, -2 from the
-    // aircraft
-    assert(m_curCol - 1 < m_map.getColCount() - 1);
-    newScanCount = scanCells(-1, -2, 1, -1, *this, m_map);
+  // Mark the footprint with word operations on the bit-packed planes
+  return scanFromState(m_map, m_state);
+}
 
-    return newScanCount;
-  }
+int Aircraft::scanGain() const { return footprintGain(m_map, m_state); }
 
-  throw std::exception(); // This should never happen
+int Aircraft::scanGain(int row, int col, Direction dir) const {
+  return footprintGain(m_map, makeState(row, col, dir));
 }
@@ -2,34 +2,7 @@
 #define AIRCRAFT
 
 #include "map.h"
-#include <iostream>
-
-// Defined directions for the aircraft to be facing
-enum class Direction {
-  dir_NORTH = 0,
-  dir_SOUTH = 1,
-  dir_EAST = 2,
-  dir_WEST = 3
-};
-
-// Used for debugging
-inline std::ostream &operator<<(std::ostream &os, const Direction dir) {
-  switch (dir) {
-  case Direction::dir_NORTH:
-    os << "NORTH";
-    break;
-  case Direction::dir_SOUTH:
-    os << "SOUTH";
-    break;
-  case Direction::dir_EAST:
-    os << "EAST";
-    break;
-  case Direction::dir_WEST:
-    os << "WEST";
-    break;
-  }
-  return os;
-}
+#include "state.h"
 
 /*
  * @brief Represents an Aircraft object as well as its direction and location on
@@ -57,6 +30,27 @@ public:
    * @return Nothing.
    */
   void moveForward();
+  /*
+   * @brief Moves the Aircraft forward several Cells in a straight line,
+   * scanning after every move, if the whole run is legal, else throws
+   * exception.
+   *
+   * @note The Cells scanned along the run form one rectangle, so it is scanned
+   * in a single pass. The route equivalent is `steps` move_FORWARD Moves.
+   *
+   * @param steps The number of forward moves.
+   *
+   * @return The number of Cells scanned over the whole run.
+   */
+  int forward(int steps);
+  /*
+   * @brief Measures how far the Aircraft can fly straight ahead.
+   *
+   * @param limit The longest run of interest.
+   *
+   * @return The number of legal forward moves in a row, capped at limit.
+   */
+  int forwardRunLength(int limit) const;
   /*
    * @brief Rotates the Aircraft's current direction to the left.
    *
@@ -75,52 +69,84 @@ public:
    * @return The number of Cells scanned.
    */
   int scan();
+  /*
+   * @brief Counts the Cells scan() would mark without marking them.
+   *
+   * @return The number of new Cells a scan from the current pose would cover.
+   */
+  int scanGain() const;
+  /*
+   * @brief Counts the Cells a scan from an arbitrary pose would mark on this
+   * Aircraft's GridMap, without moving the Aircraft or marking them.
+   *
+   * @param row The 0-indexed row of the pose.
+   * @param col The 0-indexed column of the pose.
+   * @param dir The Direction of the pose.
+   *
+   * @return The number of new Cells a scan from the pose would cover.
+   */
+  int scanGain(int row, int col, Direction dir) const;
+
+  /*
+   * @brief Builds a scan-gain table on the Aircraft's GridMap so that
+   * scanGain() and every later gain query is a table lookup. The table is
+   * kept up to date as Cells are scanned.
+   *
+   * @return Nothing.
+   */
+  void trackScanGains() { enableGainTable(m_map); }
 
   /*
    * @breif Getter for the Aircraft's 0-indexed current row.
    *
    * @return The Aircraft's current row.
    */
-  int getCurRow() const { return m_curRow; }
+  int getCurRow() const { return m_state.row; }
 
   /*
    * @brief Setter for the Aircraft's 0-indexed current row.
    *
    * @return Nothing.
    */
-  void setRow(const int row) { m_curRow = row; }
+  void setRow(const int row) { m_state.row = static_cast<std::int16_t>(row); }
 
   /*
    * @breif Getter for the Aircraft's 0-indexed current column.
    *
    * @return The Aircraft's current column.
    */
-  int getCurCol() const { return m_curCol; }
+  int getCurCol() const { return m_state.col; }
 
   /*
    * @brief Setter for the Aircraft's 0-indexed current column.
    *
    * @return Nothing.
    */
-  void setCol(const int col) { m_curCol = col; }
+  void setCol(const int col) { m_state.col = static_cast<std::int16_t>(col); }
 
   /*
    * @brief Getter for the Aircraft's current direction.
    *
    * @return The Aircraft's current direction.
    */
-  Direction getDir() const { return m_dir; }
+  Direction getDir() const { return m_state.dir; }
+
+  /*
+   * @brief Getter for the Aircraft's current pose.
+   *
+   * @return The Aircraft's row, column and Direction.
+   */
+  AircraftState getState() const { return m_state; }
 
   /*
    * @brief Getter for the Aircraft's GridMap.
    *
    * @return The Aircraft's GridMap.
    */
-  GridMap getMap() const { return m_map; }
+  const GridMap &getMap() const { return m_map; }
 
 private:
-  int m_curRow = -1, m_curCol = -1; // 0-indexed row and column values
-  Direction m_dir;
+  AircraftState m_state; // 0-indexed row and column values and Direction
   GridMap m_map;
 };
 
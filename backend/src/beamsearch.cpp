@@ -0,0 +1,233 @@
+#include "beamsearch.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "routebuilder.h"
+#include "search.h"
+#include "state.h"
+#include "threadpool.h"
+#include "traps.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// Partial routes one thread extends per task, so that a level is only split
+// across threads when it has enough work to pay for the hand-off
+constexpr int NODES_PER_TASK = 8;
+
+// The steps of a partial route: the moves of each TrapTable successor
+constexpr std::array<SuccessorBit, 3> STEP_BITS = {succ_FORWARD, succ_TURNLEFT,
+                                                   succ_TURNRIGHT};
+
+// One partial route
+struct BeamNode {
+  AircraftState state{};    // Pose at the end of the route
+  int firstStep = -1;       // Index into STEP_BITS of the first step
+  int moves = 0;            // Moves flown
+  int gain = 0;             // Cells scanned beyond the map's own
+  std::vector<int> scanned; // Those Cells, as row * columns + column
+  bool valid = false;       // False for steps that were not legal
+};
+
+/*
+ * @brief Helper function for BeamPlanner's findRoute(). Scans from a pose on
+ * top of a partial route's scans.
+ *
+ * @param map The GridMap being scanned. It is not modified.
+ * @param node The partial route. Its gain and scanned Cells are updated.
+ *
+ * @return Nothing.
+ */
+void scanFrom(const GridMap &map, BeamNode &node) {
+  // Most footprints gain nothing on the map at all; skip those quickly
+  if (footprintGain(map, node.state) == 0) {
+    return;
+  }
+  const std::array<int, 4> area = scanFootprint(node.state);
+  for (int row = area[0]; row <= area[2]; row++) {
+    for (int col = area[1]; col <= area[3]; col++) {
+      if (!map.canOccupy(row, col) || map.isScanned(row, col)) {
+        continue;
+      }
+      const int cell = row * map.getColCount() + col;
+      if (std::find(node.scanned.begin(), node.scanned.end(), cell) ==
+          node.scanned.end()) {
+        node.scanned.push_back(cell);
+        node.gain++;
+      }
+    }
+  }
+}
+
+/*
+ * @brief Helper function for BeamPlanner's findRoute(). Extends a partial
+ * route by one step.
+ *
+ * @param map The GridMap being scanned.
+ * @param traps The TrapTable of the map.
+ * @param parent The partial route.
+ * @param stepIndex Index into STEP_BITS of the step.
+ *
+ * @return The extended route; not valid if the step is illegal or flies
+ * into a box canyon the parent was not already in.
+ */
+BeamNode extend(const GridMap &map, const TrapTable &traps,
+                const BeamNode &parent, const int stepIndex) {
+  BeamNode child;
+  if (!traps.hasSuccessor(parent.state, STEP_BITS[stepIndex])) {
+    return child;
+  }
+  child.state = parent.state;
+  child.firstStep = parent.firstStep < 0 ? stepIndex : parent.firstStep;
+  child.moves = parent.moves;
+  child.gain = parent.gain;
+  child.scanned = parent.scanned;
+  if (STEP_BITS[stepIndex] != succ_FORWARD) {
+    child.state = applyMove(child.state, STEP_BITS[stepIndex] == succ_TURNLEFT
+                                             ? Moves::move_TURNLEFT
+                                             : Moves::move_TURNRIGHT);
+    child.moves++;
+    scanFrom(map, child);
+  }
+  child.state = advancedBy(child.state, 1);
+  child.moves++;
+  scanFrom(map, child);
+  child.valid =
+      traps.isEscapable(child.state) || !traps.isEscapable(parent.state);
+  return child;
+}
+
+/*
+ * @brief Helper function for BeamPlanner's findRoute(). Ranks two partial
+ * routes by Cells gained per move.
+ *
+ * @param a One route.
+ * @param b The other route.
+ *
+ * @return True if a is strictly better than b, else false.
+ */
+bool betterNode(const BeamNode &a, const BeamNode &b) {
+  // a.gain / a.moves > b.gain / b.moves, without dividing
+  return a.gain * b.moves > b.gain * a.moves;
+}
+
+/*
+ * @brief Helper function for BeamPlanner's findRoute(). Converts a step to
+ * moves.
+ *
+ * @param stepIndex Index into STEP_BITS of the step.
+ *
+ * @return The moves of the step.
+ */
+std::vector<Moves> stepMoves(const int stepIndex) {
+  switch (STEP_BITS[stepIndex]) {
+  case succ_TURNLEFT:
+    return {Moves::move_TURNLEFT, Moves::move_FORWARD};
+  case succ_TURNRIGHT:
+    return {Moves::move_TURNRIGHT, Moves::move_FORWARD};
+  case succ_FORWARD:
+    break;
+  }
+  return {Moves::move_FORWARD};
+}
+
+} // namespace
+
+BeamPlanner::BeamPlanner(Aircraft aircraft, float searchPercentage,
+                         int moveLimit, int beamWidth, int horizon,
+                         int threadCount)
+    : m_aircraft(aircraft), m_traps(m_aircraft.getMap()),
+      m_moveLimit(clampMoveLimit(moveLimit)),
+      m_searchPercentage(clampSearchPercentage(searchPercentage)),
+      m_beamWidth(beamWidth), m_horizon(horizon), m_threadCount(threadCount) {
+  // beamWidth and horizon must be greater than zero
+  if (beamWidth < 1) {
+    std::cerr << "beamWidth must be greater than 0. Updating value to 1.\n";
+    m_beamWidth = 1;
+  }
+  if (horizon < 1) {
+    std::cerr << "horizon must be greater than 0. Updating value to 1.\n";
+    m_horizon = 1;
+  }
+}
+
+std::vector<Moves> BeamPlanner::findRoute(const CancelToken &token) {
+  RouteBuilder route(m_aircraft, m_searchPercentage, m_moveLimit, token);
+  ThreadPool pool(m_threadCount);
+  SearchWorkspace workspace;
+  workspace.setCancelToken(token);
+
+  std::vector<BeamNode> beam;
+  std::vector<BeamNode> children;
+  while (route.routing()) {
+    const GridMap &map = route.getMap();
+    BeamNode root;
+    root.state = route.getState();
+    root.valid = true;
+    beam.assign(1, root);
+
+    for (int level = 0; level < m_horizon; level++) {
+      // Extend every partial route by every step, several routes per task
+      const int nodeCount = static_cast<int>(beam.size());
+      children.assign(nodeCount * STEP_BITS.size(), BeamNode());
+      const auto extendRange = [&](const int task) {
+        const int last = std::min(nodeCount, (task + 1) * NODES_PER_TASK);
+        for (int node = task * NODES_PER_TASK; node < last; node++) {
+          for (int step = 0; step < static_cast<int>(STEP_BITS.size());
+               step++) {
+            children[node * STEP_BITS.size() + step] =
+                extend(map, m_traps, beam[node], step);
+          }
+        }
+      };
+      const int taskCount = (nodeCount + NODES_PER_TASK - 1) / NODES_PER_TASK;
+      if (taskCount > 1) {
+        pool.parallelFor(taskCount, extendRange);
+      } else {
+        extendRange(0);
+      }
+
+      // Keep the best route ending at each pose, then the best beamWidth
+      children.erase(std::remove_if(children.begin(), children.end(),
+                                    [](const BeamNode &node) {
+                                      return !node.valid;
+                                    }),
+                     children.end());
+      if (children.empty()) {
+        break;
+      }
+      std::stable_sort(children.begin(), children.end(), betterNode);
+      beam.clear();
+      for (BeamNode &child : children) {
+        if (static_cast<int>(beam.size()) == m_beamWidth) {
+          break;
+        }
+        const bool duplicate =
+            std::any_of(beam.begin(), beam.end(), [&](const BeamNode &kept) {
+              return kept.state == child.state;
+            });
+        if (!duplicate) {
+          beam.push_back(std::move(child));
+        }
+      }
+    }
+
+    if (beam.front().firstStep >= 0 && beam.front().gain > 0) {
+      route.fly(stepMoves(beam.front().firstStep));
+      continue;
+    }
+    // Nothing within the horizon scans anything new; go where something does
+    const std::vector<Moves> path =
+        pathToNewScan(map, route.getState(), workspace);
+    if (path.empty()) {
+      break;
+    }
+    route.fly(path);
+  }
+  return route.getMoves();
+}
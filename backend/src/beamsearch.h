@@ -0,0 +1,81 @@
+#ifndef BEAMSEARCH
+#define BEAMSEARCH
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include "traps.h"
+#include <vector>
+
+/*
+ * @brief A coverage planner that looks several steps ahead before every
+ * move, instead of the single move RoutePlanner's greedy rule checks.
+ *
+ * A step is one of the flying moves of a TrapTable: forward, or a turn
+ * followed by forward. From the aircraft's pose the planner keeps the
+ * beamWidth best partial routes, extends each by every step for horizon
+ * steps, and ranks them by Cells gained per move. Each partial route keeps
+ * only the list of Cells it scanned on top of the map, so extending one is
+ * cheap, and the extensions of one level are evaluated in parallel. The
+ * first step of the best route is flown and the search starts again from
+ * there. When no partial route gains anything, the aircraft repositions to
+ * the closest pose that does, as RoutePlanner does.
+ */
+class BeamPlanner {
+public:
+  /*
+   * @brief Constructor for the BeamPlanner class. Builds the TrapTable of
+   * the Aircraft's map.
+   *
+   * @param aircraft The Aircraft being routed.
+   * @param searchPercentage The percentage of traversable cells to be searched
+   * for completion. Bounds checking ensures 0.01 <= searchPercentage <= 1.
+   * @param moveLimit The number of moves the Aircraft is allowed to make.
+   * @param beamWidth The number of partial routes kept at each level. Bounds
+   * checking ensures beamWidth >= 1.
+   * @param horizon The number of steps each partial route looks ahead.
+   * Bounds checking ensures horizon >= 1.
+   * @param threadCount The number of threads expanding partial routes;
+   * values below 1 use every hardware thread. Portfolios and fleets already
+   * run each planner on a pool thread, so the default is 1.
+   *
+   * @return Nothing.
+   */
+  BeamPlanner(Aircraft aircraft, float searchPercentage, int moveLimit,
+              int beamWidth = 16, int horizon = 6, int threadCount = 1);
+
+  /*
+   * @brief Plans the route. Stops as soon as the coverage target is met, the
+   * move limit is reached or the CancelToken asks it to stop.
+   *
+   * @param token Stops planning early, keeping the moves so far.
+   *
+   * @return The moves, in order.
+   */
+  std::vector<Moves> findRoute(const CancelToken &token = CancelToken());
+
+  /*
+   * @brief Getter for the beam width.
+   *
+   * @return The number of partial routes kept at each level.
+   */
+  int getBeamWidth() const { return m_beamWidth; }
+  /*
+   * @brief Getter for the horizon.
+   *
+   * @return The number of steps each partial route looks ahead.
+   */
+  int getHorizon() const { return m_horizon; }
+
+private:
+  Aircraft m_aircraft;            // The aircraft being routed
+  TrapTable m_traps;              // Mobility of every pose on the map
+  int m_moveLimit = 0;            // Moves the aircraft may use
+  float m_searchPercentage = 0.0; // Fraction of Cells to scan
+  int m_beamWidth = 0;            // Partial routes kept at each level
+  int m_horizon = 0;              // Steps each partial route looks ahead
+  int m_threadCount = 0;          // Threads expanding partial routes
+};
+
+#endif
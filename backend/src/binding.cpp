@@ -1,6 +1,16 @@
 #include "aircraft.h"
+#include "cancel.h"
+#include "fleet.h"
 #include "map.h"
+#include "optimizer.h"
+#include "partition.h"
+#include "planner.h"
+#include "portfolio.h"
+#include "replanner.h"
+#include "replay.h"
 #include "router1.h"
+#include "state.h"
+#include "tour.h"
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -38,16 +48,28 @@ PYBIND11_MODULE(backend_binding, m) {
       .value("WEST", Direction::dir_WEST)
       .export_values();
 
+  py::class_<AircraftState>(m, "AircraftState")
+      .def(py::init(&makeState), py::arg("row"), py::arg("col"),
+           py::arg("dir"))
+      .def_readwrite("row", &AircraftState::row)
+      .def_readwrite("col", &AircraftState::col)
+      .def_readwrite("dir", &AircraftState::dir);
+
   py::class_<Aircraft>(m, "Aircraft")
       .def(py::init<int, Direction, int, GridMap>(), py::arg("startRow"),
            py::arg("startDir"), py::arg("startCol"), py::arg("map"))
       .def("moveForward", &Aircraft::moveForward)
+      .def("forward", &Aircraft::forward, py::arg("steps"))
+      .def("forwardRunLength", &Aircraft::forwardRunLength, py::arg("limit"))
       .def("turnLeft", &Aircraft::turnLeft)
       .def("turnRight", &Aircraft::turnRight)
       .def("scan", &Aircraft::scan)
+      .def("scanGain", py::overload_cast<>(&Aircraft::scanGain, py::const_))
+      .def("trackScanGains", &Aircraft::trackScanGains)
       .def("getCurRow", &Aircraft::getCurRow)
       .def("getCurCol", &Aircraft::getCurCol)
       .def("getDir", &Aircraft::getDir)
+      .def("getState", &Aircraft::getState)
       .def("getMap", &Aircraft::getMap);
 
   py::enum_<Moves>(m, "Moves")
@@ -56,13 +78,171 @@ PYBIND11_MODULE(backend_binding, m) {
       .value("TURNRIGHT", Moves::move_TURNRIGHT)
       .export_values();
 
+  py::enum_<TurnPreference>(m, "TurnPreference")
+      .value("LEFTFIRST", TurnPreference::turn_LEFTFIRST)
+      .value("RIGHTFIRST", TurnPreference::turn_RIGHTFIRST)
+      .export_values();
+
+  py::enum_<RepositionMode>(m, "RepositionMode")
+      .value("NEAREST", RepositionMode::reposition_NEAREST)
+      .value("TOUR", RepositionMode::reposition_TOUR)
+      .export_values();
+
+  py::class_<CancelToken>(m, "CancelToken")
+      .def(py::init<>())
+      .def(py::init<double>(), py::arg("seconds"))
+      .def("cancel", &CancelToken::cancel)
+      .def("isCancelled", &CancelToken::isCancelled)
+      .def("stopRequested", &CancelToken::stopRequested);
+
   py::class_<RoutePlanner>(m, "RoutePlanner")
-      .def(py::init<Aircraft, float, int>(), py::arg("aircraft"),
-           py::arg("searchPercentage"), py::arg("moveLimit"))
-      .def("findRoute", &RoutePlanner::findRoute)
+      .def(py::init<Aircraft, float, int, TurnPreference, RepositionMode,
+                    int>(),
+           py::arg("aircraft"), py::arg("searchPercentage"),
+           py::arg("moveLimit"),
+           py::arg("turnPreference") = TurnPreference::turn_LEFTFIRST,
+           py::arg("repositionMode") = RepositionMode::reposition_NEAREST,
+           py::arg("threadCount") = 1)
+      .def("findRoute", &RoutePlanner::findRoute,
+           py::arg("token") = CancelToken(),
+           py::call_guard<py::gil_scoped_release>())
       .def("findNearestUnscannedPosRow",
            &RoutePlanner::findNearestUnscannedPosRow)
       .def("findNearestUnscannedPosCol",
            &RoutePlanner::findNearestUnscannedPosCol)
       .def("getSearchPercentage", &RoutePlanner::getSearchPercentage);
+
+  py::class_<ReplayResult>(m, "ReplayResult")
+      .def_readonly("valid", &ReplayResult::valid)
+      .def_readonly("firstIllegalMove", &ReplayResult::firstIllegalMove)
+      .def_readonly("movesFlown", &ReplayResult::movesFlown)
+      .def_readonly("scannedCount", &ReplayResult::scannedCount)
+      .def_readonly("coverage", &ReplayResult::coverage)
+      .def_readonly("initialGain", &ReplayResult::initialGain)
+      .def_readonly("finalState", &ReplayResult::finalState)
+      .def_readonly("stepGains", &ReplayResult::stepGains)
+      .def_readonly("states", &ReplayResult::states)
+      .def_readonly("scannedCells", &ReplayResult::scannedCells);
+
+  py::class_<PlanResult>(m, "PlanResult")
+      .def_readonly("moves", &PlanResult::moves)
+      .def_readonly("start", &PlanResult::start)
+      .def_readonly("valid", &PlanResult::valid)
+      .def_readonly("targetMet", &PlanResult::targetMet)
+      .def_readonly("scannedCount", &PlanResult::scannedCount)
+      .def_readonly("coverage", &PlanResult::coverage)
+      .def_readonly("planSeconds", &PlanResult::planSeconds)
+      .def_readonly("interrupted", &PlanResult::interrupted);
+
+  py::class_<CoveragePlanner>(m, "CoveragePlanner")
+      .def("plan", &CoveragePlanner::plan, py::arg("map"), py::arg("start"),
+           py::arg("searchPercentage"), py::arg("moveLimit"),
+           py::arg("token") = CancelToken(),
+           py::call_guard<py::gil_scoped_release>());
+
+  m.def("makePlanner", &makePlanner, py::arg("name"));
+  m.def("getPlannerNames", &getPlannerNames);
+  m.def("getPlannerDescription", &getPlannerDescription, py::arg("name"));
+  m.def("planRoute", &planRoute, py::arg("name"), py::arg("map"),
+        py::arg("start"), py::arg("searchPercentage"), py::arg("moveLimit"),
+        py::arg("token") = CancelToken(),
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("evaluateRoute", &evaluateRoute, py::arg("map"), py::arg("start"),
+        py::arg("moves"), py::arg("searchPercentage"));
+  m.def("optimizeRoute", &optimizeRoute, py::arg("map"), py::arg("start"),
+        py::arg("route"), py::call_guard<py::gil_scoped_release>());
+
+  py::class_<CoverageTour>(m, "CoverageTour")
+      .def_readonly("clusters", &CoverageTour::clusters)
+      .def_readonly("length", &CoverageTour::length);
+
+  m.def("planCoverageTour", &planCoverageTour, py::arg("map"),
+        py::arg("startRow"), py::arg("startCol"), py::arg("threadCount") = 0);
+
+  py::class_<ImproveResult>(m, "ImproveResult")
+      .def_readonly("moves", &ImproveResult::moves)
+      .def_readonly("rounds", &ImproveResult::rounds)
+      .def_readonly("windowsKept", &ImproveResult::windowsKept)
+      .def_readonly("interrupted", &ImproveResult::interrupted);
+
+  m.def("improveRoute", &improveRoute, py::arg("map"), py::arg("start"),
+        py::arg("route"), py::arg("searchPercentage"), py::arg("roundLimit"),
+        py::arg("threadCount") = 0, py::arg("seed") = 1,
+        py::arg("token") = CancelToken(),
+        py::call_guard<py::gil_scoped_release>());
+
+  py::enum_<PortfolioGoal>(m, "PortfolioGoal")
+      .value("FEWESTMOVES", PortfolioGoal::goal_FEWESTMOVES)
+      .value("MOSTCOVERAGE", PortfolioGoal::goal_MOSTCOVERAGE)
+      .export_values();
+
+  py::class_<PortfolioEntry>(m, "PortfolioEntry")
+      .def(py::init([](const std::string &planner, const Direction heading) {
+             return PortfolioEntry{planner, heading};
+           }),
+           py::arg("planner"), py::arg("heading"))
+      .def_readwrite("planner", &PortfolioEntry::planner)
+      .def_readwrite("heading", &PortfolioEntry::heading);
+
+  py::class_<PortfolioResult>(m, "PortfolioResult")
+      .def_readonly("results", &PortfolioResult::results)
+      .def_readonly("bestIndex", &PortfolioResult::bestIndex)
+      .def("getBest", &PortfolioResult::getBest);
+
+  m.def("defaultPortfolio", &defaultPortfolio);
+  m.def("planPortfolio", &planPortfolio, py::arg("map"), py::arg("start"),
+        py::arg("searchPercentage"), py::arg("moveLimit"), py::arg("entries"),
+        py::arg("goal") = PortfolioGoal::goal_FEWESTMOVES,
+        py::arg("threadCount") = 0, py::arg("token") = CancelToken(),
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<RegionPartition>(m, "RegionPartition")
+      .def(py::init<const GridMap &, int, int>(), py::arg("map"),
+           py::arg("regionCount"), py::arg("rounds") = 8)
+      .def(py::init<const GridMap &, const std::vector<AircraftState> &>(),
+           py::arg("map"), py::arg("seeds"))
+      .def("getRegion", &RegionPartition::getRegion)
+      .def("getRegions", &RegionPartition::getRegions)
+      .def("getRegionCount", &RegionPartition::getRegionCount)
+      .def("getRegionSize", &RegionPartition::getRegionSize)
+      .def("getImbalance", &RegionPartition::getImbalance)
+      .def("restrictTo", &RegionPartition::restrictTo);
+
+  py::class_<FleetResult>(m, "FleetResult")
+      .def_readonly("routes", &FleetResult::routes)
+      .def_readonly("regions", &FleetResult::regions)
+      .def_readonly("scannedCount", &FleetResult::scannedCount)
+      .def_readonly("coverage", &FleetResult::coverage)
+      .def_readonly("targetMet", &FleetResult::targetMet)
+      .def_readonly("missionLength", &FleetResult::missionLength)
+      .def_readonly("planSeconds", &FleetResult::planSeconds)
+      .def_readonly("interrupted", &FleetResult::interrupted);
+
+  m.def("planFleet", &planFleet, py::arg("map"), py::arg("starts"),
+        py::arg("searchPercentage"), py::arg("moveLimit"),
+        py::arg("planner") = "spanning_tree", py::arg("threadCount") = 0,
+        py::arg("token") = CancelToken(),
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<MissionReplanner>(m, "MissionReplanner")
+      .def(py::init<const GridMap &, const AircraftState &,
+                    std::vector<Moves>>(),
+           py::arg("map"), py::arg("start"), py::arg("route"))
+      .def("advance", &MissionReplanner::advance, py::arg("moveCount"))
+      .def("markUntraversable", &MissionReplanner::markUntraversable,
+           py::arg("row"), py::arg("col"))
+      .def("pathTo", &MissionReplanner::pathTo, py::arg("row"),
+           py::arg("col"))
+      .def("getRemainingRoute", &MissionReplanner::getRemainingRoute)
+      .def("getState", &MissionReplanner::getState)
+      .def("getMap", &MissionReplanner::getMap,
+           py::return_value_policy::reference_internal)
+      .def("getExpandedCount", &MissionReplanner::getExpandedCount);
+
+  m.def("replayRoute", &replayRoute, py::arg("map"), py::arg("start"),
+        py::arg("moves"), py::arg("recordCells") = false);
+  m.def("replayRoutes", &replayRoutes, py::arg("map"), py::arg("starts"),
+        py::arg("routes"), py::arg("threadCount") = 0,
+        py::call_guard<py::gil_scoped_release>());
 }
@@ -0,0 +1,285 @@
+#ifndef BITGRID
+#define BITGRID
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * @brief Counts the set bits in a 64-bit word.
+ *
+ * @param word The word being counted.
+ *
+ * @return The number of set bits.
+ */
+inline int popcount64(std::uint64_t word) {
+#if defined(_MSC_VER)
+  return static_cast<int>(__popcnt64(word));
+#else
+  return __builtin_popcountll(word);
+#endif
+}
+
+/*
+ * @brief Counts the zero bits below the lowest set bit of a word.
+ *
+ * @param word The word being examined. Must not be zero.
+ *
+ * @return The index of the lowest set bit.
+ */
+inline int countTrailingZeros64(std::uint64_t word) {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward64(&index, word);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+/*
+ * @brief Counts the zero bits above the highest set bit of a word.
+ *
+ * @param word The word being examined. Must not be zero.
+ *
+ * @return 63 minus the index of the highest set bit.
+ */
+inline int countLeadingZeros64(std::uint64_t word) {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanReverse64(&index, word);
+  return 63 - static_cast<int>(index);
+#else
+  return __builtin_clzll(word);
+#endif
+}
+
+/*
+ * @brief A rectangular plane of bits, one per Cell, stored row-major.
+ *
+ * Every row is padded to a whole number of 64-bit words so that a span of
+ * columns can be read, masked, and written with word operations instead of
+ * one Cell at a time. Padding bits are always zero.
+ */
+class BitGrid {
+public:
+  static constexpr int WORD_BITS = 64;
+
+  BitGrid() = default;
+
+  /*
+   * @brief Constructs a BitGrid with every bit cleared.
+   *
+   * @param rows The number of rows in the plane.
+   * @param cols The number of columns in the plane.
+   *
+   * @return Nothing.
+   */
+  BitGrid(int rows, int cols)
+      : m_rowCount(rows), m_colCount(cols),
+        m_stride((cols + WORD_BITS - 1) / WORD_BITS),
+        m_words(static_cast<std::size_t>(rows) * m_stride, 0) {}
+
+  /*
+   * @brief Reads the bit for a Cell. No bounds checking is performed.
+   *
+   * @param row The row (y coordinate) being accessed.
+   * @param col The column (x coordinate) being accessed.
+   *
+   * @return True if the bit is set.
+   */
+  bool test(int row, int col) const {
+    return ((word(row, col) >> (col % WORD_BITS)) & 1U) != 0;
+  }
+
+  /*
+   * @brief Sets the bit for a Cell. No bounds checking is performed.
+   *
+   * @param row The row (y coordinate) being accessed.
+   * @param col The column (x coordinate) being accessed.
+   *
+   * @return Nothing.
+   */
+  void set(int row, int col) {
+    word(row, col) |= std::uint64_t{1} << (col % WORD_BITS);
+  }
+
+  /*
+   * @brief Clears the bit for a Cell. No bounds checking is performed.
+   *
+   * @param row The row (y coordinate) being accessed.
+   * @param col The column (x coordinate) being accessed.
+   *
+   * @return Nothing.
+   */
+  void reset(int row, int col) {
+    word(row, col) &= ~(std::uint64_t{1} << (col % WORD_BITS));
+  }
+
+  /*
+   * @brief Builds the mask selecting columns [firstCol, lastCol] inside the
+   * word that holds columns [wordIndex * 64, wordIndex * 64 + 63].
+   *
+   * @param wordIndex The index of the word within its row.
+   * @param firstCol The first column of the span (inclusive).
+   * @param lastCol The last column of the span (inclusive).
+   *
+   * @return The mask, which is zero if the span misses the word.
+   */
+  static std::uint64_t spanMask(int wordIndex, int firstCol, int lastCol) {
+    const int wordStart = wordIndex * WORD_BITS;
+    const int lo = firstCol > wordStart ? firstCol - wordStart : 0;
+    const int hi = lastCol < wordStart + WORD_BITS - 1 ? lastCol - wordStart
+                                                       : WORD_BITS - 1;
+    if (lo > hi) {
+      return 0;
+    }
+    const std::uint64_t upTo =
+        hi == WORD_BITS - 1 ? ~std::uint64_t{0}
+                            : (std::uint64_t{1} << (hi + 1)) - 1;
+    return upTo & ~((std::uint64_t{1} << lo) - 1);
+  }
+
+  /*
+   * @brief Measures a run of set bits along a row, one word at a time.
+   *
+   * @param row The row being examined.
+   * @param col The first column of the run.
+   * @param forward True to walk toward higher columns, false toward lower.
+   * @param limit The longest run of interest.
+   *
+   * @return The number of consecutive set bits starting at col, capped at
+   * limit. Columns off the plane count as clear.
+   */
+  int runLength(int row, int col, bool forward, int limit) const {
+    int length = 0;
+    while (length < limit && col >= 0 && col < m_colCount) {
+      const int wordIndex = col / WORD_BITS;
+      const int bit = col % WORD_BITS;
+      const std::uint64_t clear = ~rowWords(row)[wordIndex];
+      int ones = 0;
+      bool stopped = false;
+      if (forward) {
+        // Clear bits at or above `bit`; padding bits are clear
+        const std::uint64_t ahead = clear >> bit;
+        stopped = ahead != 0;
+        ones = stopped ? countTrailingZeros64(ahead) : WORD_BITS - bit;
+        col += ones;
+      } else {
+        // Clear bits at or below `bit`
+        const std::uint64_t behind = clear << (WORD_BITS - 1 - bit);
+        stopped = behind != 0;
+        ones = stopped ? countLeadingZeros64(behind) : bit + 1;
+        col -= ones;
+      }
+      length += ones;
+      if (stopped) {
+        break;
+      }
+    }
+    return length < limit ? length : limit;
+  }
+
+  /*
+   * @brief Finds where a run of set bits begins along a row, walking away
+   * from a column one word at a time.
+   *
+   * @param row The row being examined.
+   * @param col The column the walk starts from. Its bit is only compared with
+   * the first column examined.
+   * @param forward True to walk toward higher columns, false toward lower.
+   * @param limit The number of columns to examine.
+   *
+   * @return The distance from col to the first examined column whose bit is
+   * set while the bit before it on the walk is clear, or 0 if there is none
+   * within limit. Columns off the plane count as clear.
+   */
+  int firstRise(int row, int col, bool forward, int limit) const {
+    const std::uint64_t *words = rowWords(row);
+    const int step = forward ? 1 : -1;
+    int first = col + step;
+    int last = col + step * limit;
+    if (forward) {
+      last = last < m_colCount - 1 ? last : m_colCount - 1;
+    } else {
+      std::swap(first, last);
+      first = first > 0 ? first : 0;
+    }
+    if (first > last) {
+      return 0;
+    }
+
+    const int firstWord = (forward ? first : last) / WORD_BITS;
+    const int lastWord = (forward ? last : first) / WORD_BITS;
+    for (int wordIndex = firstWord;; wordIndex += step) {
+      const std::uint64_t bits = words[wordIndex];
+      std::uint64_t rises = 0;
+      if (forward) {
+        // Each column is compared with the one below it
+        const std::uint64_t carry =
+            wordIndex > 0 ? words[wordIndex - 1] >> (WORD_BITS - 1) : 0;
+        rises = bits & ~((bits << 1) | carry);
+      } else {
+        // Each column is compared with the one above it
+        const std::uint64_t next =
+            wordIndex + 1 < m_stride ? words[wordIndex + 1] : 0;
+        const std::uint64_t carry = next << (WORD_BITS - 1);
+        rises = bits & ~((bits >> 1) | carry);
+      }
+      rises &= spanMask(wordIndex, first, last);
+      if (rises != 0) {
+        const int hit =
+            wordIndex * WORD_BITS +
+            (forward ? countTrailingZeros64(rises)
+                     : WORD_BITS - 1 - countLeadingZeros64(rises));
+        return forward ? hit - col : col - hit;
+      }
+      if (wordIndex == lastWord) {
+        return 0;
+      }
+    }
+  }
+
+  /*
+   * @brief Getter for the words backing a row.
+   *
+   * @param row The row being accessed.
+   *
+   * @return Pointer to the first of getStride() words for the row.
+   */
+  const std::uint64_t *rowWords(int row) const {
+    return &m_words[static_cast<std::size_t>(row) * m_stride];
+  }
+  std::uint64_t *rowWords(int row) {
+    return &m_words[static_cast<std::size_t>(row) * m_stride];
+  }
+
+  /*
+   * @brief Getter for the number of words in each row.
+   *
+   * @return The number of words in each row.
+   */
+  int getStride() const { return m_stride; }
+  int getRowCount() const { return m_rowCount; }
+  int getColCount() const { return m_colCount; }
+
+private:
+  std::uint64_t word(int row, int col) const {
+    return m_words[static_cast<std::size_t>(row) * m_stride + col / WORD_BITS];
+  }
+  std::uint64_t &word(int row, int col) {
+    return m_words[static_cast<std::size_t>(row) * m_stride + col / WORD_BITS];
+  }
+
+  int m_rowCount = 0;                 // 1-indexed row count
+  int m_colCount = 0;                 // 1-indexed column count
+  int m_stride = 0;                   // words per row
+  std::vector<std::uint64_t> m_words; // row-major words
+};
+
+#endif
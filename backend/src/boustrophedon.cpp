@@ -0,0 +1,260 @@
+#include "boustrophedon.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "routebuilder.h"
+#include "state.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Lanes are this many columns apart: the width of the scanner footprint
+constexpr int LANE_SPACING = 3;
+
+/*
+ * @brief Helper function for decomposeBoustrophedon(). Lists the open
+ * intervals of rows in a column.
+ *
+ * @param map The GridMap being decomposed.
+ * @param col The column.
+ *
+ * @return The intervals as {top, bottom, cell} with cell set to -1, from top
+ * to bottom.
+ */
+std::vector<std::array<int, 3>> openIntervals(const GridMap &map,
+                                              const int col) {
+  std::vector<std::array<int, 3>> intervals;
+  const int rows = map.getRowCount();
+  for (int row = 0; row < rows; row++) {
+    if (map.canOccupy(row, col)) {
+      const int bottom = row + map.openRunLength(row, col, 1, 0, rows);
+      intervals.push_back({{row, bottom, -1}});
+      row = bottom;
+    }
+  }
+  return intervals;
+}
+
+/*
+ * @brief Helper function for decomposeBoustrophedon(). Records that two cells
+ * share a border.
+ *
+ * @param cells The cells.
+ * @param first One cell.
+ * @param second The other cell.
+ *
+ * @return Nothing.
+ */
+void link(std::vector<SweepCell> &cells, const int first, const int second) {
+  std::vector<int> &neighbours = cells[first].neighbours;
+  if (first != second &&
+      std::find(neighbours.begin(), neighbours.end(), second) ==
+          neighbours.end()) {
+    neighbours.push_back(second);
+    cells[second].neighbours.push_back(first);
+  }
+}
+
+/*
+ * @brief Helper function for BoustrophedonPlanner. The columns a cell's lanes
+ * run down, from left to right.
+ *
+ * @param cell The cell.
+ *
+ * @return One column per lane.
+ */
+std::vector<int> laneColumns(const SweepCell &cell) {
+  std::vector<int> lanes;
+  const int lastCol = cell.lastCol();
+  // The first lane's scanner reaches the cell's left edge; a lane on the last
+  // column covers whatever is left on the right
+  for (int col = cell.firstCol + 1;; col += LANE_SPACING) {
+    lanes.push_back(std::min(col, lastCol));
+    if (col >= lastCol - 1) {
+      break;
+    }
+  }
+  return lanes;
+}
+
+/*
+ * @brief Helper function for BoustrophedonPlanner. Estimates how far a pose
+ * is from the nearer end of a cell.
+ *
+ * @param cell The cell.
+ * @param state The pose.
+ *
+ * @return The Manhattan distance to the closest end of the first or last
+ * lane.
+ */
+int distanceToCell(const SweepCell &cell, const AircraftState &state) {
+  const std::vector<int> lanes = laneColumns(cell);
+  int best = -1;
+  for (const int col : {lanes.front(), lanes.back()}) {
+    const int offset = col - cell.firstCol;
+    const int rowDistance =
+        std::min(std::abs(state.row - cell.topRows[offset]),
+                 std::abs(state.row - cell.bottomRows[offset]));
+    const int distance = std::abs(state.col - col) + rowDistance;
+    if (best < 0 || distance < best) {
+      best = distance;
+    }
+  }
+  return best;
+}
+
+/*
+ * @brief Helper function for BoustrophedonPlanner's findRoute(). Sweeps one
+ * cell with vertical lanes, starting from the end of the cell closer to the
+ * aircraft.
+ *
+ * @param cell The cell being swept.
+ * @param route The route being built.
+ *
+ * @return Nothing.
+ */
+void sweepCell(const SweepCell &cell, RouteBuilder &route) {
+  std::vector<int> lanes = laneColumns(cell);
+  const AircraftState start = route.getState();
+  if (std::abs(start.col - lanes.back()) <
+      std::abs(start.col - lanes.front())) {
+    std::reverse(lanes.begin(), lanes.end());
+  }
+
+  for (const int col : lanes) {
+    if (!route.routing()) {
+      return;
+    }
+    const int top = cell.topRows[col - cell.firstCol];
+    const int bottom = cell.bottomRows[col - cell.firstCol];
+    // Fly the lane from whichever end is closer
+    const int row = route.getState().row;
+    const bool down = std::abs(row - top) <= std::abs(row - bottom);
+    const AircraftState entry =
+        down ? makeState(top, col, Direction::dir_SOUTH)
+             : makeState(bottom, col, Direction::dir_NORTH);
+    const int steps = bottom - top;
+
+    // Skip lanes that would scan nothing new
+    const std::array<int, 4> area =
+        steps > 0 ? sweptFootprint(entry, steps) : scanFootprint(entry);
+    if (route.getMap().scanAreaGain(area[0], area[1], area[2], area[3]) ==
+        0) {
+      continue;
+    }
+    if (route.flyTo(entry.row, entry.col, entry.dir)) {
+      route.flyStraight(steps);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<SweepCell> decomposeBoustrophedon(const GridMap &map) {
+  std::vector<SweepCell> cells;
+  std::vector<std::array<int, 3>> previous; // Intervals of the last column
+
+  for (int col = 0; col < map.getColCount(); col++) {
+    std::vector<std::array<int, 3>> current = openIntervals(map, col);
+
+    // Pair up the overlapping intervals of the two columns. Both lists are
+    // sorted, so one merge-like pass finds every overlap.
+    std::vector<std::pair<std::size_t, std::size_t>> overlaps;
+    std::vector<int> previousCount(previous.size(), 0);
+    std::vector<int> currentCount(current.size(), 0);
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < previous.size() && j < current.size()) {
+      if (previous[i][0] <= current[j][1] && current[j][0] <= previous[i][1]) {
+        overlaps.emplace_back(i, j);
+        previousCount[i]++;
+        currentCount[j]++;
+      }
+      if (previous[i][1] < current[j][1]) {
+        i++;
+      } else {
+        j++;
+      }
+    }
+
+    // An interval continues a cell only when the two correspond one to one
+    for (const auto &overlap : overlaps) {
+      if (previousCount[overlap.first] == 1 &&
+          currentCount[overlap.second] == 1) {
+        current[overlap.second][2] = previous[overlap.first][2];
+      }
+    }
+    for (auto &interval : current) {
+      if (interval[2] < 0) {
+        interval[2] = static_cast<int>(cells.size());
+        cells.emplace_back();
+        cells.back().firstCol = col;
+      }
+      SweepCell &cell = cells[interval[2]];
+      cell.topRows.push_back(interval[0]);
+      cell.bottomRows.push_back(interval[1]);
+    }
+    for (const auto &overlap : overlaps) {
+      link(cells, previous[overlap.first][2], current[overlap.second][2]);
+    }
+    previous = std::move(current);
+  }
+  return cells;
+}
+
+BoustrophedonPlanner::BoustrophedonPlanner(Aircraft aircraft,
+                                           float searchPercentage,
+                                           int moveLimit)
+    : m_aircraft(aircraft), m_moveLimit(clampMoveLimit(moveLimit)),
+      m_searchPercentage(clampSearchPercentage(searchPercentage)) {
+  m_cells = decomposeBoustrophedon(m_aircraft.getMap());
+}
+
+std::vector<Moves> BoustrophedonPlanner::findRoute(const CancelToken &token) {
+  RouteBuilder route(m_aircraft, m_searchPercentage, m_moveLimit, token);
+
+  // Sweep the cells, moving on to an unswept neighbour of the last cell when
+  // there is one and to the closest unswept cell otherwise
+  std::vector<bool> swept(m_cells.size(), false);
+  int last = -1;
+  while (route.routing()) {
+    const AircraftState state = route.getState();
+    int next = -1;
+    int nextDistance = 0;
+    const auto consider = [&](const int cell) {
+      if (swept[cell]) {
+        return;
+      }
+      const int distance = distanceToCell(m_cells[cell], state);
+      if (next < 0 || distance < nextDistance) {
+        next = cell;
+        nextDistance = distance;
+      }
+    };
+    if (last >= 0) {
+      for (const int neighbour : m_cells[last].neighbours) {
+        consider(neighbour);
+      }
+    }
+    if (next < 0) {
+      for (int cell = 0; cell < getCellCount(); cell++) {
+        consider(cell);
+      }
+    }
+    if (next < 0) {
+      break; // Every cell is swept
+    }
+    sweepCell(m_cells[next], route);
+    swept[next] = true;
+    last = next;
+  }
+
+  route.pickUpMissed();
+  return route.getMoves();
+}
@@ -0,0 +1,97 @@
+#ifndef BOUSTROPHEDON
+#define BOUSTROPHEDON
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include <vector>
+
+/*
+ * @brief One cell of a boustrophedon decomposition: a run of consecutive
+ * columns that each hold a single open interval of rows, with every interval
+ * sharing a row with the one in the next column. A cell contains no
+ * obstacles, so it can be swept with straight up-and-down lanes.
+ */
+struct SweepCell {
+  int firstCol = 0;              // Leftmost column of the cell
+  std::vector<int> topRows;      // First open row in each column
+  std::vector<int> bottomRows;   // Last open row in each column
+  std::vector<int> neighbours;   // Cells that share a border with this one
+
+  /*
+   * @brief Getter for the rightmost column of the cell.
+   *
+   * @return The last column.
+   */
+  int lastCol() const {
+    return firstCol + static_cast<int>(topRows.size()) - 1;
+  }
+};
+
+/*
+ * @brief Cuts the traversable Cells of a map into obstacle-free SweepCells
+ * with a single left-to-right pass over the columns. A cell ends wherever
+ * the open intervals of two neighbouring columns stop corresponding one to
+ * one, which is where an obstacle begins, ends, splits the free space or
+ * merges it.
+ *
+ * @param map The GridMap being decomposed.
+ *
+ * @return The cells, in order of their first column.
+ */
+std::vector<SweepCell> decomposeBoustrophedon(const GridMap &map);
+
+/*
+ * @brief A coverage planner that sweeps the map cell by cell instead of
+ * deciding every move greedily (boustrophedon cell decomposition).
+ *
+ * Each SweepCell is flown in vertical lanes three columns apart, matching the
+ * width of the scanner, alternating down and up. Cells are visited
+ * neighbour-first, and the short legs between lanes and cells are found with
+ * jump point search. Once every cell is swept, RouteBuilder::pickUpMissed()
+ * collects whatever the lanes missed.
+ *
+ * @read https://en.wikipedia.org/wiki/Boustrophedon_cell_decomposition
+ */
+class BoustrophedonPlanner {
+public:
+  /*
+   * @brief Constructor for the BoustrophedonPlanner class. Decomposes the
+   * Aircraft's map.
+   *
+   * @param aircraft The Aircraft being routed.
+   * @param searchPercentage The percentage of traversable cells to be searched
+   * for completion. Bounds checking ensures 0.01 <= searchPercentage <= 1.
+   * @param moveLimit The number of moves the Aircraft is allowed to make.
+   *
+   * @return Nothing.
+   */
+  BoustrophedonPlanner(Aircraft aircraft, float searchPercentage,
+                       int moveLimit);
+
+  /*
+   * @brief Plans the route. Stops as soon as the coverage target is met, the
+   * move limit is reached or the CancelToken asks it to stop.
+   *
+   * @param token Stops planning early, keeping the moves so far.
+   *
+   * @return The moves, in order.
+   */
+  std::vector<Moves> findRoute(const CancelToken &token = CancelToken());
+
+  /*
+   * @brief Getter for the number of cells the map was decomposed into.
+   *
+   * @return The number of SweepCells.
+   */
+  int getCellCount() const { return static_cast<int>(m_cells.size()); }
+
+private:
+  Aircraft m_aircraft;            // The aircraft being routed
+  std::vector<SweepCell> m_cells; // Decomposition of the aircraft's map
+  int m_moveLimit = 0;            // Moves the aircraft may use
+  float m_searchPercentage = 0.0; // Fraction of Cells to scan
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CANCEL
+#define CANCEL
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+/*
+ * @brief Tells a running planner to stop, either when another thread calls
+ * cancel() or when a deadline passes.
+ *
+ * Copies share one flag, so a caller keeps a copy and cancels it while the
+ * planner polls its own. Planners poll between moves and every few thousand
+ * search steps, then return the route flown so far, which is always legal.
+ */
+class CancelToken {
+public:
+  /*
+   * @brief Constructs a CancelToken without a deadline.
+   *
+   * @return Nothing.
+   */
+  CancelToken() : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+  /*
+   * @brief Constructs a CancelToken with a deadline.
+   *
+   * @param seconds The wall-clock time planning may take from now.
+   *
+   * @return Nothing.
+   */
+  explicit CancelToken(const double seconds) : CancelToken() {
+    using Clock = std::chrono::steady_clock;
+    m_deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                    std::chrono::duration<double>(seconds));
+    m_hasDeadline = true;
+  }
+
+  /*
+   * @brief Asks every planner holding a copy of the token to stop. Safe to
+   * call from any thread.
+   *
+   * @return Nothing.
+   */
+  void cancel() const { m_cancelled->store(true, std::memory_order_relaxed); }
+  /*
+   * @brief Determines if cancel() has been called on any copy.
+   *
+   * @return True if cancelled, else false.
+   */
+  bool isCancelled() const {
+    return m_cancelled->load(std::memory_order_relaxed);
+  }
+  /*
+   * @brief Determines if planning should stop.
+   *
+   * @return True if cancelled or past the deadline, else false.
+   */
+  bool stopRequested() const {
+    return isCancelled() ||
+           (m_hasDeadline && std::chrono::steady_clock::now() >= m_deadline);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> m_cancelled;   // Shared by every copy
+  std::chrono::steady_clock::time_point m_deadline; // When planning must stop
+  bool m_hasDeadline = false;                       // False to plan untimed
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "dstarlite.h"
+#include "map.h"
+#include "search.h"
+#include "state.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Distance of poses that cannot reach the goal; one more move cannot overflow
+constexpr int UNREACHABLE = std::numeric_limits<int>::max() / 2;
+
+// Moves tried from every pose, in the order the router has always used
+constexpr std::array<Moves, 3> MOVE_ORDER = {
+    Moves::move_FORWARD, Moves::move_TURNLEFT, Moves::move_TURNRIGHT};
+
+/*
+ * @brief Helper function for DStarLite. Finds the poses one legal move
+ * before a pose.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param id The pose.
+ * @param predecessors Filled with the ids of the poses.
+ *
+ * @return The number of poses found.
+ */
+int predecessorIds(const GridMap &map, const int id,
+                   std::array<int, 3> &predecessors) {
+  const AircraftState state = stateFromId(map, id);
+  int count = 0;
+  const AircraftState behind = advancedBy(state, -1);
+  if (map.canOccupy(behind.row, behind.col)) {
+    predecessors[count++] = stateId(map, behind);
+  }
+  // Turns happen in place, from either neighbouring heading
+  predecessors[count++] =
+      stateId(map, makeState(state.row, state.col, turnedRight(state.dir)));
+  predecessors[count++] =
+      stateId(map, makeState(state.row, state.col, turnedLeft(state.dir)));
+  return count;
+}
+
+} // namespace
+
+DStarLite::DStarLite(const GridMap &map, const int goalRow, const int goalCol)
+    : m_map(&map), m_goalRow(goalRow), m_goalCol(goalCol) {}
+
+int DStarLite::heuristic(const int id) const {
+  const AircraftState state = stateFromId(*m_map, id);
+  return std::abs(state.row - m_start.row) + std::abs(state.col - m_start.col);
+}
+
+DStarLite::Key DStarLite::calculateKey(const int id) const {
+  const int best = std::min(m_g[id], m_rhs[id]);
+  return {best + heuristic(id) + m_keyModifier, best};
+}
+
+void DStarLite::updateVertex(const int id) {
+  const AircraftState state = stateFromId(*m_map, id);
+  int rhs = UNREACHABLE;
+  if (m_map->canOccupy(state.row, state.col)) {
+    if (state.row == m_goalRow && state.col == m_goalCol) {
+      rhs = 0;
+    } else {
+      for (const Moves move : MOVE_ORDER) {
+        AircraftState next{};
+        if (step(state, move, *m_map, next)) {
+          rhs = std::min(rhs, m_g[stateId(*m_map, next)] + 1);
+        }
+      }
+    }
+  }
+  m_rhs[id] = std::min(rhs, UNREACHABLE);
+  if (m_g[id] != m_rhs[id]) {
+    m_open.emplace(calculateKey(id), id);
+  }
+}
+
+void DStarLite::computeShortestPath() {
+  const int startId = stateId(*m_map, m_start);
+  std::array<int, 3> predecessors{};
+  while (!m_open.empty()) {
+    const Entry top = m_open.top();
+    const int id = top.second;
+    // Skip entries for poses settled since they were queued
+    if (m_g[id] == m_rhs[id]) {
+      m_open.pop();
+      continue;
+    }
+    if (!(top.first < calculateKey(startId)) &&
+        m_rhs[startId] == m_g[startId]) {
+      break;
+    }
+    m_open.pop();
+    // The start moved since the pose was queued; queue it again in order
+    const Key key = calculateKey(id);
+    if (top.first < key) {
+      m_open.emplace(key, id);
+      continue;
+    }
+
+    m_expandedCount++;
+    const int count = predecessorIds(*m_map, id, predecessors);
+    if (m_g[id] > m_rhs[id]) {
+      m_g[id] = m_rhs[id];
+    } else {
+      m_g[id] = UNREACHABLE;
+      updateVertex(id);
+    }
+    for (int index = 0; index < count; index++) {
+      updateVertex(predecessors[index]);
+    }
+  }
+}
+
+std::vector<Moves> DStarLite::findPath(const AircraftState &start) {
+  if ((start.row == m_goalRow && start.col == m_goalCol) ||
+      !m_map->canOccupy(start.row, start.col)) {
+    return {};
+  }
+  if (!m_started) {
+    // Seed the backwards search with every pose on the goal Cell
+    m_g.assign(stateCount(*m_map), UNREACHABLE);
+    m_rhs.assign(stateCount(*m_map), UNREACHABLE);
+    m_start = start;
+    m_started = true;
+    for (int dir = 0; dir < 4; dir++) {
+      const Direction facing = static_cast<Direction>(dir);
+      updateVertex(stateId(*m_map, makeState(m_goalRow, m_goalCol, facing)));
+    }
+  } else if (!(start == m_start)) {
+    // Keys queued for the old start overestimate by at most this much
+    m_keyModifier +=
+        std::abs(start.row - m_start.row) + std::abs(start.col - m_start.col);
+    m_start = start;
+  }
+  computeShortestPath();
+
+  // Follow the settled distances down to the goal
+  const int length = m_rhs[stateId(*m_map, start)];
+  if (length >= UNREACHABLE) {
+    return {};
+  }
+  std::vector<Moves> path;
+  AircraftState state = start;
+  while (state.row != m_goalRow || state.col != m_goalCol) {
+    int best = UNREACHABLE;
+    Moves bestMove = Moves::move_FORWARD;
+    AircraftState bestNext = state;
+    for (const Moves move : MOVE_ORDER) {
+      AircraftState next{};
+      if (step(state, move, *m_map, next) &&
+          m_g[stateId(*m_map, next)] < best) {
+        best = m_g[stateId(*m_map, next)];
+        bestMove = move;
+        bestNext = next;
+      }
+    }
+    if (best >= UNREACHABLE || static_cast<int>(path.size()) >= length) {
+      return {};
+    }
+    path.push_back(bestMove);
+    state = bestNext;
+  }
+  return path;
+}
+
+void DStarLite::cellBlocked(const int row, const int col) {
+  if (!m_started || !m_map->isWithinBounds(row, col)) {
+    return; // The first query reads the map as it is then
+  }
+  for (int dir = 0; dir < 4; dir++) {
+    const AircraftState onCell =
+        makeState(row, col, static_cast<Direction>(dir));
+    updateVertex(stateId(*m_map, onCell));
+    // The pose facing the Cell from behind just lost its forward move
+    const AircraftState facing = advancedBy(onCell, -1);
+    if (m_map->canOccupy(facing.row, facing.col)) {
+      updateVertex(stateId(*m_map, facing));
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef DSTARLITE
+#define DSTARLITE
+
+#include "map.h"
+#include "state.h"
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/*
+ * @brief Shortest paths from a moving aircraft to one goal Cell on a map
+ * whose Cells may be marked untraversable during the mission (D* Lite).
+ *
+ * The search runs backwards from every pose on the goal Cell, so it keeps the
+ * number of moves from each pose it has settled to the goal. As the aircraft
+ * flies, the start pose moves without invalidating that work, and when a Cell
+ * is blocked only the poses whose distance ran through it are repaired.
+ * Queries after a small edit therefore touch a small part of the map, where
+ * a fresh search would revisit everything between the aircraft and the goal.
+ *
+ * @read http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf
+ */
+class DStarLite {
+public:
+  /*
+   * @brief Constructs a DStarLite. No search is run until the first query.
+   *
+   * @param map The GridMap paths run on. Must outlive the DStarLite; report
+   * every Cell later marked untraversable to cellBlocked().
+   * @param goalRow The row to reach.
+   * @param goalCol The column to reach.
+   *
+   * @return Nothing.
+   */
+  DStarLite(const GridMap &map, int goalRow, int goalCol);
+
+  /*
+   * @brief Finds a shortest path from a pose to the goal Cell, reusing the
+   * search state of earlier queries.
+   *
+   * @param start The pose the path starts from. Must be on the map.
+   *
+   * @return The moves, in order. Empty if the aircraft is already on the goal
+   * Cell or the goal cannot be reached.
+   */
+  std::vector<Moves> findPath(const AircraftState &start);
+  /*
+   * @brief Repairs the search after a Cell was marked untraversable on the
+   * map. The repair itself is deferred to the next query.
+   *
+   * @param row The row of the blocked Cell.
+   * @param col The column of the blocked Cell.
+   *
+   * @return Nothing.
+   */
+  void cellBlocked(int row, int col);
+
+  /*
+   * @brief Getter for the goal row.
+   *
+   * @return The row every path ends on.
+   */
+  int getGoalRow() const { return m_goalRow; }
+  /*
+   * @brief Getter for the goal column.
+   *
+   * @return The column every path ends on.
+   */
+  int getGoalCol() const { return m_goalCol; }
+  /*
+   * @brief Getter for the work done so far.
+   *
+   * @return The number of poses expanded by every query so far.
+   */
+  long long getExpandedCount() const { return m_expandedCount; }
+
+private:
+  // Queue priority: {min(g, rhs) + heuristic + m_keyModifier, min(g, rhs)}
+  using Key = std::pair<int, int>;
+  using Entry = std::pair<Key, int>; // {key, pose id}
+
+  const GridMap *m_map;   // The map paths run on
+  int m_goalRow = 0;      // Row every path ends on
+  int m_goalCol = 0;      // Column every path ends on
+  std::vector<int> m_g;   // Settled moves to the goal from each pose
+  std::vector<int> m_rhs; // Best move plus m_g of the pose it leads to
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+      m_open;                    // Poses with m_g != m_rhs; stale entries too
+  AircraftState m_start{};       // Start of the latest query
+  int m_keyModifier = 0;         // Heuristic drop as the start moved
+  bool m_started = false;        // True once a query has run
+  long long m_expandedCount = 0; // Poses expanded by every query
+
+  // Lower bound on the moves between the start and a pose
+  int heuristic(int id) const;
+  // Priority of a pose in m_open
+  Key calculateKey(int id) const;
+
+  /*
+   * @brief Recomputes a pose's one-move lookahead and queues the pose if it
+   * no longer matches its settled distance.
+   *
+   * @param id The pose.
+   *
+   * @return Nothing.
+   */
+  void updateVertex(int id);
+  /*
+   * @brief Settles poses in key order until the start pose's distance is
+   * known.
+   *
+   * @return Nothing.
+   */
+  void computeShortestPath();
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "fleet.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "partition.h"
+#include "planner.h"
+#include "replay.h"
+#include "state.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+FleetResult planFleet(const GridMap &map,
+                      const std::vector<AircraftState> &starts,
+                      const float searchPercentage, const int moveLimit,
+                      const std::string &planner, const int threadCount,
+                      const CancelToken &token) {
+  const auto began = std::chrono::steady_clock::now();
+  const int aircraftCount = static_cast<int>(starts.size());
+  const float target = clampSearchPercentage(searchPercentage);
+  const int limit = clampMoveLimit(moveLimit);
+
+  FleetResult fleet;
+  std::vector<AircraftState> origins;
+  for (const AircraftState &start : starts) {
+    const Aircraft aircraft(start.row, start.dir, start.col, map);
+    origins.push_back(aircraft.getState());
+  }
+  const RegionPartition partition(map, origins);
+  fleet.regions = partition.getRegions();
+
+  // Each aircraft sees the other regions as already scanned and aims for
+  // the target fraction of its own
+  fleet.routes.resize(aircraftCount);
+  ThreadPool pool(threadCount);
+  pool.parallelFor(aircraftCount, [&](int aircraft) {
+    PlanResult &route = fleet.routes[aircraft];
+    const int shareCount = std::ceil(
+        target * static_cast<float>(partition.getRegionSize(aircraft)));
+    if (shareCount == 0) {
+      route.targetMet = true; // Nothing to scan, so the aircraft stays put
+      return;
+    }
+    GridMap share = map;
+    partition.restrictTo(share, aircraft);
+    // A planner aims for at least PERCENT1 of the whole map, so a smaller
+    // share is planned at that and cut off where the share is met
+    const float shareTarget =
+        std::max(PERCENT1, static_cast<float>(shareCount) /
+                               static_cast<float>(map.getTraversableCount()));
+    route = makePlanner(planner)->plan(share, origins[aircraft], shareTarget,
+                                       limit, token);
+    route.targetMet =
+        trimToScanCount(share, origins[aircraft], route.moves, shareCount);
+    route.interrupted = route.interrupted && !route.targetMet;
+  });
+
+  // The fleet's coverage is the union of every route's scans. Each route's
+  // statistics are restated on the whole map, but whether it met its target
+  // is still judged against its share, as it was planned
+  GridMap covered = map;
+  for (int aircraft = 0; aircraft < aircraftCount; aircraft++) {
+    PlanResult &route = fleet.routes[aircraft];
+    const bool interrupted = route.interrupted;
+    const bool shareMet = route.targetMet;
+    route = evaluateRoute(map, origins[aircraft], std::move(route.moves),
+                          target);
+    route.interrupted = interrupted;
+    route.targetMet = shareMet;
+    fleet.interrupted = fleet.interrupted || interrupted;
+    const ReplayResult replay =
+        replayRoute(map, origins[aircraft], route.moves);
+    for (int pose = -1; pose < replay.movesFlown; pose++) {
+      const std::array<int, 4> area = scanFootprint(
+          pose < 0 ? origins[aircraft] : replay.states[pose]);
+      fleet.scannedCount += covered.scanArea(area[0], area[1], area[2],
+                                             area[3]);
+    }
+    fleet.missionLength = std::max(fleet.missionLength,
+                                   static_cast<int>(route.moves.size()));
+  }
+  fleet.coverage = static_cast<float>(fleet.scannedCount) /
+                   static_cast<float>(map.getTraversableCount());
+  fleet.targetMet =
+      fleet.scannedCount >=
+      std::ceil(target * static_cast<float>(map.getTraversableCount()));
+  fleet.planSeconds = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - began)
+                          .count();
+  return fleet;
+}
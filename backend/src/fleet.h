@@ -0,0 +1,57 @@
+#ifndef FLEET
+#define FLEET
+
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "state.h"
+#include <string>
+#include <vector>
+
+/*
+ * @brief The routes of a fleet covering one map together.
+ */
+struct FleetResult {
+  std::vector<PlanResult> routes; // One per aircraft, in start order
+  std::vector<int> regions;       // Aircraft assigned each Cell, -1 for none
+  int scannedCount = 0;           // Cells scanned by the fleet as a whole
+  float coverage = 0.0;           // Fraction of traversable Cells scanned
+  bool targetMet = false;         // True if the coverage target was reached
+  int missionLength = 0;          // Moves in the longest route
+  double planSeconds = 0.0;       // Wall-clock time spent planning
+  bool interrupted = false;       // True if a CancelToken cut any route short
+};
+
+/*
+ * @brief Plans one route per aircraft for a shared coverage target.
+ *
+ * The traversable Cells are split into one balanced RegionPartition region
+ * per aircraft, grown from its start. Each aircraft is planned on its own
+ * thread restricted to its region, so no aircraft spends moves re-covering
+ * another's Cells. Each aircraft's share of the target is the target
+ * fraction of its region, and its route stops once the share is met. A
+ * route's scannedCount and coverage are measured on the whole map, while its
+ * targetMet tells whether it met that share.
+ *
+ * @param map The GridMap to cover. It is not modified.
+ * @param starts The aircraft start poses. Untraversable starts are moved to
+ * the closest traversable Cell, as Aircraft does.
+ * @param searchPercentage The fraction of traversable Cells the fleet must
+ * scan.
+ * @param moveLimit The number of moves each aircraft may use.
+ * @param planner The name of the registered planner flying each aircraft.
+ * @param threadCount The number of threads; values below 1 use every
+ * hardware thread.
+ * @param token Stops every aircraft's planning early, keeping the routes so
+ * far.
+ *
+ * @return The routes, the regions and the fleet's coverage.
+ */
+FleetResult planFleet(const GridMap &map,
+                      const std::vector<AircraftState> &starts,
+                      float searchPercentage, int moveLimit,
+                      const std::string &planner = "spanning_tree",
+                      int threadCount = 0,
+                      const CancelToken &token = CancelToken());
+
+#endif
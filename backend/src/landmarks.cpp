@@ -0,0 +1,120 @@
+#include "landmarks.h"
+#include "map.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for the LandmarkTable constructor. Records the BFS
+ * distance from one Cell to every traversable Cell.
+ *
+ * @param map The GridMap being measured.
+ * @param source The Cell index the distances are measured from.
+ * @param workspace The reusable BFS buffers.
+ * @param distances Filled with one distance per Cell; -1 where unreachable.
+ *
+ * @return The Cell index of the farthest reachable Cell.
+ */
+int cellDistances(const GridMap &map, const int source,
+                  SearchWorkspace &workspace, int *distances) {
+  const int cols = map.getColCount();
+  const int cellCount = map.getRowCount() * cols;
+  std::fill(distances, distances + cellCount, -1);
+
+  // Directions for movement (up, down, left, and right)
+  const std::array<int, 4> dRow = {0, 0, -1, 1};
+  const std::array<int, 4> dCol = {-1, 1, 0, 0};
+
+  workspace.begin(cellCount);
+  workspace.push(source);
+  distances[source] = 0;
+  int farthest = source;
+
+  while (!workspace.frontierEmpty()) {
+    const int curr = workspace.pop();
+    farthest = curr; // BFS pops Cells in order of distance
+    for (int i = 0; i < 4; i++) {
+      const int newRow = curr / cols + dRow[i];
+      const int newCol = curr % cols + dCol[i];
+      if (!map.canOccupy(newRow, newCol)) {
+        continue;
+      }
+      const int next = newRow * cols + newCol;
+      if (!workspace.isVisited(next)) {
+        distances[next] = distances[curr] + 1;
+        workspace.push(next);
+      }
+    }
+  }
+  return farthest;
+}
+
+} // namespace
+
+LandmarkTable::LandmarkTable(const GridMap &map, const int landmarkCount)
+    : m_colCount(map.getColCount()),
+      m_cellCount(map.getRowCount() * map.getColCount()) {
+  // Seed the selection from any traversable Cell
+  int seed = -1;
+  for (int cell = 0; cell < m_cellCount && seed < 0; cell++) {
+    if (map.canOccupy(cell / m_colCount, cell % m_colCount)) {
+      seed = cell;
+    }
+  }
+  if (seed < 0 || landmarkCount < 1) {
+    return; // No landmarks: lowerBound() falls back to Manhattan distance
+  }
+
+  SearchWorkspace workspace;
+  std::vector<int> seedDistances(m_cellCount);
+  int next = cellDistances(map, seed, workspace, seedDistances.data());
+
+  // Distance from each Cell to its closest landmark so far
+  std::vector<int> closest(m_cellCount, std::numeric_limits<int>::max());
+  m_distances.reserve(static_cast<std::size_t>(landmarkCount) * m_cellCount);
+
+  for (int k = 0; k < landmarkCount; k++) {
+    m_landmarks.push_back(next);
+    m_distances.resize(m_distances.size() + m_cellCount);
+    int *distances = m_distances.data() + k * m_cellCount;
+    cellDistances(map, next, workspace, distances);
+
+    // The next landmark is the Cell farthest from every landmark so far
+    int best = -1;
+    int bestDistance = 0;
+    for (int cell = 0; cell < m_cellCount; cell++) {
+      if (distances[cell] < 0) {
+        continue;
+      }
+      closest[cell] = std::min(closest[cell], distances[cell]);
+      if (closest[cell] > bestDistance) {
+        bestDistance = closest[cell];
+        best = cell;
+      }
+    }
+    if (best < 0) {
+      break; // Every reachable Cell is already a landmark
+    }
+    next = best;
+  }
+}
+
+int LandmarkTable::lowerBound(const int fromRow, const int fromCol,
+                              const int toRow, const int toCol) const {
+  int bound = std::abs(fromRow - toRow) + std::abs(fromCol - toCol);
+  const int from = fromRow * m_colCount + fromCol;
+  const int to = toRow * m_colCount + toCol;
+  for (std::size_t k = 0; k < m_landmarks.size(); k++) {
+    const int *distances = m_distances.data() + k * m_cellCount;
+    if (distances[from] >= 0 && distances[to] >= 0) {
+      bound = std::max(bound, std::abs(distances[from] - distances[to]));
+    }
+  }
+  return bound;
+}
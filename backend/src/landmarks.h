@@ -0,0 +1,77 @@
+#ifndef LANDMARKS
+#define LANDMARKS
+
+#include "map.h"
+#include <vector>
+
+/*
+ * @brief Exact BFS distances from a few landmark Cells, used as an A*
+ * heuristic (ALT: A*, landmarks, triangle inequality).
+ *
+ * For any landmark L, the distance between Cells a and b is at least
+ * |d(L, a) - d(L, b)|. Walls that Manhattan distance ignores are therefore
+ * accounted for. Every forward move changes a Cell distance by at most 1 and
+ * turns change nothing, so the bound is a consistent heuristic for the
+ * aircraft's pose graph too.
+ *
+ * The table is a snapshot of the map's terrain. Rebuild it after Cells are
+ * marked untraversable.
+ */
+class LandmarkTable {
+public:
+  /*
+   * @brief Picks landmarks by farthest-point selection and records their BFS
+   * distances over traversable Cells.
+   *
+   * The first landmark is the Cell farthest from an arbitrary traversable
+   * Cell; each next one maximizes its distance to the closest landmark so far.
+   *
+   * @param map The GridMap the distances are measured on.
+   * @param landmarkCount The number of landmarks to place. Fewer are placed if
+   * the map runs out of distinct Cells.
+   *
+   * @return Nothing.
+   */
+  LandmarkTable(const GridMap &map, int landmarkCount = 8);
+
+  /*
+   * @brief A lower bound on the number of forward moves between two Cells.
+   *
+   * @param fromRow The row of the first Cell.
+   * @param fromCol The column of the first Cell.
+   * @param toRow The row of the second Cell.
+   * @param toCol The column of the second Cell.
+   *
+   * @return The largest landmark bound, and never less than the Manhattan
+   * distance.
+   */
+  int lowerBound(int fromRow, int fromCol, int toRow, int toCol) const;
+
+  /*
+   * @brief Getter for the number of landmarks placed.
+   *
+   * @return The number of landmarks.
+   */
+  int getLandmarkCount() const { return static_cast<int>(m_landmarks.size()); }
+
+  /*
+   * @brief Getter for the Cell index (row * columns + column) of a landmark.
+   *
+   * @param landmark The landmark, in placement order.
+   *
+   * @return The Cell index.
+   */
+  int getLandmarkCell(const int landmark) const {
+    return m_landmarks[landmark];
+  }
+
+private:
+  int m_colCount = 0;          // Columns of the map the table was built on
+  int m_cellCount = 0;         // Cells of the map the table was built on
+  std::vector<int> m_landmarks; // Cell index of each landmark
+  // Distance from landmark k to Cell c at [k * m_cellCount + c]; -1 where the
+  // Cell cannot be reached
+  std::vector<int> m_distances;
+};
+
+#endif
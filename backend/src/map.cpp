@@ -1,12 +1,15 @@
 #include "map.h"
+#include "bitgrid.h"
+#include "workspace.h"
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <fstream>
 #include <iostream>
-#include <queue>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -102,49 +105,43 @@ void rowVectorValidation(std::vector<Cell> &rowVector, const int xSize,
  * @param startRow The row to start BFS at.
  * @param startCol The column to start BFS at.
  * @param map The GridMap being searched.
+ * @param workspace The reusable BFS buffers.
  *
  * @return The <row, column> coordinate pair of the closest traversable Cell.
  */
 std::pair<int, int> closestTraversableBFS(const int &startRow,
-                                          const int &startCol, GridMap &map) {
-  struct BFSCell {
-    int row;
-    int col;
-  };
-
-  const int rows = map.getRowCount();
+                                          const int &startCol, GridMap &map,
+                                          SearchWorkspace &workspace) {
   const int cols = map.getColCount();
 
-  // visited matrix ensures each Cell is visited only once
-  std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-
-  // BFS queue
-  std::queue<BFSCell> q;
-  q.push({startRow, startCol});
-  visited[startRow][startCol] = true;
+  // Cells are numbered row * cols + col; the workspace tracks visited Cells
+  // and holds the BFS queue
+  workspace.begin(map.getRowCount() * cols);
+  workspace.push(startRow * cols + startCol);
 
   // Directions for movement (up, down, left, and right)
   std::array<int, 4> dRow = {0, 0, -1, 1};
   std::array<int, 4> dCol = {-1, 1, 0, 0};
 
-  while (!q.empty()) {
-    const BFSCell curr = q.front();
-    q.pop();
+  while (!workspace.frontierEmpty()) {
+    const int curr = workspace.pop();
+    const int currRow = curr / cols;
+    const int currCol = curr % cols;
 
     // Check if current Cell is traversable
-    if (map.isTraversable(curr.row, curr.col)) {
-      return {curr.row, curr.col};
+    if (map.isTraversable(currRow, currCol)) {
+      return {currRow, currCol};
     }
 
     // If not, explore the neighboring Cells
     for (int i = 0; i < 4; i++) {
-      const int newRow = curr.row + dRow[i];
-      const int newCol = curr.col + dCol[i];
+      const int newRow = currRow + dRow[i];
+      const int newCol = currCol + dCol[i];
 
       // Ensure new Cell is within bounds and not yet visited
-      if (map.isWithinBounds(newRow, newCol) && !visited[newRow][newCol]) {
-        visited[newRow][newCol] = true;
-        q.push({newRow, newCol});
+      if (map.isWithinBounds(newRow, newCol) &&
+          !workspace.isVisited(newRow * cols + newCol)) {
+        workspace.push(newRow * cols + newCol);
       }
     }
   }
@@ -159,18 +156,13 @@ std::pair<int, int> closestTraversableBFS(const int &startRow,
  * @param startRow The row to start BFS at.
  * @param startCol The column to start BFS at.
  * @param map The GridMap BFS is performed on.
+ * @param workspace The reusable BFS buffers.
  *
  * @return True if the Cell is contiguous with at least 21% of all traversable
  * Cells, else false.
  */
 bool contiguousTraversableBFS(const int &startRow, const int &startCol,
-                              const GridMap &map) {
-  struct BFSCell {
-    int row;
-    int col;
-  };
-
-  const int rows = map.getRowCount();
+                              const GridMap &map, SearchWorkspace &workspace) {
   const int cols = map.getColCount();
 
   const float PERCENT21 = 0.21;
@@ -179,21 +171,17 @@ bool contiguousTraversableBFS(const int &startRow, const int &startCol,
       std::ceil(static_cast<float>(map.getTraversableCount()) * PERCENT21);
   int currentTraversability = 1;
 
-  // visited matrix ensures each Cell is visited only once
-  std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-
-  // BFS queue
-  std::queue<BFSCell> q;
-  q.push({startRow, startCol});
-  visited[startRow][startCol] = true;
+  // Cells are numbered row * cols + col; the workspace tracks visited Cells
+  // and holds the BFS queue
+  workspace.begin(map.getRowCount() * cols);
+  workspace.push(startRow * cols + startCol);
 
   // Directions for movement (up, down, left, and right)
   std::array<int, 4> dRow = {0, 0, -1, 1};
   std::array<int, 4> dCol = {-1, 1, 0, 0};
 
-  while (!q.empty()) {
-    const BFSCell curr = q.front();
-    q.pop();
+  while (!workspace.frontierEmpty()) {
+    const int curr = workspace.pop();
 
     // Check if traverability goal has been hit
     if (currentTraversability >= goalTraversablility) {
@@ -202,15 +190,15 @@ bool contiguousTraversableBFS(const int &startRow, const int &startCol,
 
     // Explore the neighboring Cells
     for (int i = 0; i < 4; i++) {
-      const int newRow = curr.row + dRow[i];
-      const int newCol = curr.col + dCol[i];
+      const int newRow = curr / cols + dRow[i];
+      const int newCol = curr % cols + dCol[i];
 
       // Ensure new Cell is within bounds and not yet visited
-      if (map.isWithinBounds(newRow, newCol) && !visited[newRow][newCol] &&
+      if (map.isWithinBounds(newRow, newCol) &&
+          !workspace.isVisited(newRow * cols + newCol) &&
           map.isTraversable(newRow, newCol)) {
-        visited[newRow][newCol] = true;
         currentTraversability++;
-        q.push({newRow, newCol});
+        workspace.push(newRow * cols + newCol);
       }
     }
   }
@@ -232,16 +220,19 @@ std::pair<int, int> getFloodFillCoordinates(GridMap &map) {
   int col = std::ceil(map.getColCount() / 2);
 
   // If the middle Cell is not traversable, BFS out to closest traversable Cell
+  // One workspace serves every BFS below
+  SearchWorkspace workspace;
+
   if (!map.isTraversable(row, col)) {
     const std::pair<int, int> closestTraversableCord =
-        closestTraversableBFS(row, col, map);
+        closestTraversableBFS(row, col, map, workspace);
     row = closestTraversableCord.first;
     col = closestTraversableCord.second;
   }
 
   // Do a BFS until finding at least 21% of total traversable Cells (confirming
   // that it is the main contiguous traversable area)
-  if (contiguousTraversableBFS(row, col, map)) {
+  if (contiguousTraversableBFS(row, col, map, workspace)) {
     return {row, col};
   }
 
@@ -250,7 +241,7 @@ std::pair<int, int> getFloodFillCoordinates(GridMap &map) {
   for (int loopRow = 0; loopRow < map.getRowCount(); loopRow++) {
     for (int loopCol = 0; loopCol < map.getColCount(); loopCol++) {
       if (map.isTraversable(loopRow, loopCol)) {
-        if (contiguousTraversableBFS(loopRow, loopCol, map)) {
+        if (contiguousTraversableBFS(loopRow, loopCol, map, workspace)) {
           return {loopRow, loopCol};
         }
       }
@@ -291,9 +282,69 @@ void floodFill(const int row, const int col, GridMap &map) {
   floodFill(row, col - 1, map);
 }
 
+/*
+ * @brief Word-parallel scanning kernel shared by GridMap's scanArea() and
+ * scanAreaGain().
+ *
+ * For every row of the rectangle (clipped to the map), each 64-bit word the
+ * column span touches yields its new Cells as traversable & ~scanned & span.
+ * They are counted with a popcount and, if requested, ORed into the scanned
+ * plane. A 3-wide footprint touches at most two words per row.
+ *
+ * @param traversable The traversable plane of the map.
+ * @param scanned The scanned plane of the map.
+ * @param markInto The plane new Cells are ORed into, or nullptr to only count.
+ * @param firstRow The first row of the rectangle (inclusive).
+ * @param firstCol The first column of the rectangle (inclusive).
+ * @param lastRow The last row of the rectangle (inclusive).
+ * @param lastCol The last column of the rectangle (inclusive).
+ * @param onMarked Called as onMarked(row, wordIndex, newBits) for every word
+ * whose new Cells were marked.
+ *
+ * @return The number of traversable, unscanned Cells in the rectangle.
+ */
+template <typename OnMarked>
+int scanWords(const BitGrid &traversable, const BitGrid &scanned,
+              BitGrid *markInto, int firstRow, int firstCol, int lastRow,
+              int lastCol, OnMarked onMarked) {
+  // Clip the rectangle to the map
+  firstRow = std::max(firstRow, 0);
+  firstCol = std::max(firstCol, 0);
+  lastRow = std::min(lastRow, traversable.getRowCount() - 1);
+  lastCol = std::min(lastCol, traversable.getColCount() - 1);
+  if (firstRow > lastRow || firstCol > lastCol) {
+    return 0;
+  }
+
+  const int firstWord = firstCol / BitGrid::WORD_BITS;
+  const int lastWord = lastCol / BitGrid::WORD_BITS;
+
+  int newScanCount = 0;
+  for (int row = firstRow; row <= lastRow; row++) {
+    const std::uint64_t *travRow = traversable.rowWords(row);
+    const std::uint64_t *scanRow = scanned.rowWords(row);
+    for (int word = firstWord; word <= lastWord; word++) {
+      const std::uint64_t fresh = travRow[word] & ~scanRow[word] &
+                                  BitGrid::spanMask(word, firstCol, lastCol);
+      newScanCount += popcount64(fresh);
+      if (markInto != nullptr && fresh != 0) {
+        markInto->rowWords(row)[word] |= fresh;
+        onMarked(row, word, fresh);
+      }
+    }
+  }
+  return newScanCount;
+}
+
 } // namespace
 
 GridMap::GridMap(int width, std::string filePath) : m_colCount(width) {
+  if (width > MAX_MAP_EXTENT) {
+    std::cerr << "ERROR: A map may be at most " << MAX_MAP_EXTENT
+              << " columns wide, but " << width << " were given.\n";
+    throw std::exception();
+  }
+
   // Holds the input CSV
   std::ifstream inputFile;
 
@@ -312,6 +363,11 @@ GridMap::GridMap(int width, std::string filePath) : m_colCount(width) {
 
   // Iterate over each line of the csv file
   while (std::getline(inputFile, line)) {
+    if (rowCount == MAX_MAP_EXTENT) {
+      std::cerr << "ERROR: A map may be at most " << MAX_MAP_EXTENT
+                << " rows tall.\n";
+      throw std::exception();
+    }
     std::vector<Cell> rowVector;
     std::stringstream curLine(line);
     int colCount = 0;
@@ -355,6 +411,20 @@ GridMap::GridMap(int width, std::string filePath) : m_colCount(width) {
   // Add the number of rows to the ySize private member
   m_rowCount = rowCount;
 
+  // Pack traversability into words for the scanning kernel.
+  // markUntraversable() keeps the packed copy in sync from here on
+  m_traversableBits = BitGrid(m_rowCount, m_colCount);
+  m_traversableCols = BitGrid(m_colCount, m_rowCount);
+  m_scannedBits = BitGrid(m_rowCount, m_colCount);
+  for (int row = 0; row < m_rowCount; row++) {
+    for (int col = 0; col < m_colCount; col++) {
+      if (m_grid[row][col].traversable) {
+        m_traversableBits.set(row, col);
+        m_traversableCols.set(col, row);
+      }
+    }
+  }
+
   // Now a flood-fill will be performed to capture areas of traversable Cells
   // that can not be accessed by the main contiguous area of traverable Cells
   const std::pair<int, int> floodFillCoord = getFloodFillCoordinates(*this);
@@ -437,7 +507,7 @@ bool GridMap::isScanned(int row, int column) const {
   assert(row < m_rowCount && column < m_colCount);
 
   // Return the Cell's scanned value
-  return m_grid[row][column].scanned;
+  return m_scannedBits.test(row, column);
 }
 
 void GridMap::markScanned(int row, int column) {
@@ -446,7 +516,7 @@ void GridMap::markScanned(int row, int column) {
          "Attempted out of bounds access");
 
   // Determine if the Cell was already scanned
-  if (m_grid[row][column].scanned) {
+  if (m_scannedBits.test(row, column)) {
     // If so, print a note and leave it be
     std::cerr << "Note: Requested a Cell at [" << row << "][" << column
               << "] is already scanned\n";
@@ -454,7 +524,130 @@ void GridMap::markScanned(int row, int column) {
   }
 
   // Else, mark it as scanned
-  m_grid[row][column].scanned = true;
+  m_scannedBits.set(row, column);
+  if (hasGainTable() && m_traversableBits.test(row, column)) {
+    discountGain(row, column);
+  }
+}
+
+void GridMap::markUntraversable(int row, int column) {
+  // An unscanned traversable Cell no longer counts toward any scan gain
+  if (hasGainTable() && m_traversableBits.test(row, column) &&
+      !m_scannedBits.test(row, column)) {
+    discountGain(row, column);
+  }
+  m_grid[row][column].traversable = false;
+  m_traversableBits.reset(row, column);
+  m_traversableCols.reset(column, row);
+}
+
+int GridMap::scanArea(int firstRow, int firstCol, int lastRow, int lastCol) {
+  if (!hasGainTable()) {
+    return scanWords(m_traversableBits, m_scannedBits, &m_scannedBits,
+                     firstRow, firstCol, lastRow, lastCol,
+                     [](int, int, std::uint64_t) {});
+  }
+
+  // With a gain table, each new Cell also discounts the poses that cover it
+  return scanWords(m_traversableBits, m_scannedBits, &m_scannedBits, firstRow,
+                   firstCol, lastRow, lastCol,
+                   [this](int row, int word, std::uint64_t fresh) {
+                     while (fresh != 0) {
+                       discountGain(row, word * BitGrid::WORD_BITS +
+                                             countTrailingZeros64(fresh));
+                       fresh &= fresh - 1;
+                     }
+                   });
+}
+
+void GridMap::buildGainTable(
+    const std::array<std::array<int, 4>, 4> &footprints) {
+  m_footprints = footprints;
+  m_gainTable.assign(static_cast<std::size_t>(m_rowCount) * m_colCount * 4, 0);
+  for (int row = 0; row < m_rowCount; row++) {
+    for (int col = 0; col < m_colCount; col++) {
+      for (int heading = 0; heading < 4; heading++) {
+        const std::array<int, 4> &area = m_footprints[heading];
+        m_gainTable[gainIndex(row, col, heading)] = static_cast<std::uint8_t>(
+            scanAreaGain(row + area[0], col + area[1], row + area[2],
+                         col + area[3]));
+      }
+    }
+  }
+}
+
+void GridMap::discountGain(int row, int column) {
+  for (int heading = 0; heading < 4; heading++) {
+    // A pose covers the Cell when the Cell lies inside the pose's footprint
+    const std::array<int, 4> &area = m_footprints[heading];
+    for (int poseRow = std::max(row - area[2], 0);
+         poseRow <= std::min(row - area[0], m_rowCount - 1); poseRow++) {
+      for (int poseCol = std::max(column - area[3], 0);
+           poseCol <= std::min(column - area[1], m_colCount - 1); poseCol++) {
+        m_gainTable[gainIndex(poseRow, poseCol, heading)]--;
+      }
+    }
+  }
+}
+
+int GridMap::scanAreaGain(int firstRow, int firstCol, int lastRow,
+                          int lastCol) const {
+  return scanWords(m_traversableBits, m_scannedBits, nullptr, firstRow,
+                   firstCol, lastRow, lastCol, [](int, int, std::uint64_t) {});
+}
+
+int GridMap::scanAreaInto(BitGrid &overlay, int firstRow, int firstCol,
+                          int lastRow, int lastCol,
+                          std::vector<std::pair<int, int>> *newCells) const {
+  return scanWords(m_traversableBits, overlay, &overlay, firstRow, firstCol,
+                   lastRow, lastCol,
+                   [newCells](int row, int word, std::uint64_t fresh) {
+                     while (newCells != nullptr && fresh != 0) {
+                       newCells->emplace_back(
+                           row, word * BitGrid::WORD_BITS +
+                                    countTrailingZeros64(fresh));
+                       fresh &= fresh - 1;
+                     }
+                   });
+}
+
+int GridMap::openRunLength(int row, int col, int dRow, int dCol,
+                           int limit) const {
+  if (!isWithinBounds(row, col)) {
+    return 0;
+  }
+  // Horizontal runs walk a row of the traversable plane, vertical runs walk a
+  // row of its transpose
+  if (dRow == 0) {
+    return m_traversableBits.runLength(row, col + dCol, dCol > 0, limit);
+  }
+  return m_traversableCols.runLength(col, row + dRow, dRow > 0, limit);
+}
+
+int GridMap::sideOpeningDistance(int row, int col, int dRow, int dCol,
+                                 int limit) const {
+  if (!isWithinBounds(row, col)) {
+    return 0;
+  }
+  // The lines on either side are rows of the traversable plane for
+  // horizontal lines and rows of its transpose for vertical ones
+  const bool horizontal = dRow == 0;
+  const BitGrid &plane = horizontal ? m_traversableBits : m_traversableCols;
+  const int line = horizontal ? row : col;
+  const int position = horizontal ? col : row;
+  const bool forward = horizontal ? dCol > 0 : dRow > 0;
+
+  int closest = 0;
+  for (const int side : {line - 1, line + 1}) {
+    if (side < 0 || side >= plane.getRowCount()) {
+      continue;
+    }
+    const int distance = plane.firstRise(side, position, forward, limit);
+    if (distance > 0 && (closest == 0 || distance < closest)) {
+      closest = distance;
+    }
+  }
+  return closest;
 }
 
 void GridMap::markColored(int row, int column) {
@@ -474,6 +667,8 @@ Cell GridMap::getCell(int row, int column) {
   assert(row < m_rowCount && column < m_colCount &&
          "Attempted out of bounds access");
 
-  // Return the Cell
-  return m_grid[row][column];
+  // Return the Cell, with its scanned value taken from the scanned plane
+  Cell cell = m_grid[row][column];
+  cell.scanned = m_scannedBits.test(row, column);
+  return cell;
 }
@@ -1,7 +1,12 @@
 #ifndef MAP
 #define MAP
 
+#include "bitgrid.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Representation of cells in the map
@@ -11,6 +16,10 @@ struct Cell {
   bool colored;
 };
 
+// The most rows or columns a GridMap may have. AircraftState packs rows and
+// columns into 16 bits, leaving room for a pose one move off the edge.
+constexpr int MAX_MAP_EXTENT = INT16_MAX;
+
 /*
  * @brief Represents a 2D rectangular grid map loaded from a CSV file.
  *
@@ -24,7 +33,8 @@ public:
    * Populates the grid of Cells from a given CSV file.
    * The error handling strategy of this constructor is to never crash on bad
    * data, but instead convert bad data to non-traversable Cells, or truncate
-   * extra Cells in a row with too many columns.
+   * extra Cells in a row with too many columns. A map wider or taller than
+   * MAX_MAP_EXTENT is rejected with an exception instead.
    *
    * @param width Represents the 1-indexed x-dimension (number of columns) of
    * the grid.
@@ -64,6 +74,123 @@ public:
    */
   void markScanned(int row, int column);
 
+  /*
+   * @brief Scans every traversable, unscanned Cell in a rectangle.
+   *
+   * The rectangle is clipped to the map and processed one 64-bit word at a
+   * time: the new Cells of a word are traversable & ~scanned & span, they are
+   * counted with a popcount and ORed into the scanned plane.
+   *
+   * @param firstRow The first row of the rectangle (inclusive).
+   * @param firstCol The first column of the rectangle (inclusive).
+   * @param lastRow The last row of the rectangle (inclusive).
+   * @param lastCol The last column of the rectangle (inclusive).
+   *
+   * @return The number of Cells newly marked as scanned.
+   */
+  int scanArea(int firstRow, int firstCol, int lastRow, int lastCol);
+  /*
+   * @brief Counts the Cells scanArea() would mark, without marking them.
+   *
+   * @param firstRow The first row of the rectangle (inclusive).
+   * @param firstCol The first column of the rectangle (inclusive).
+   * @param lastRow The last row of the rectangle (inclusive).
+   * @param lastCol The last column of the rectangle (inclusive).
+   *
+   * @return The number of traversable, unscanned Cells in the rectangle.
+   */
+  int scanAreaGain(int firstRow, int firstCol, int lastRow, int lastCol) const;
+
+  /*
+   * @brief Scans a rectangle into a separate scanned plane (a scan overlay)
+   * instead of this GridMap's own, leaving the GridMap untouched. Lets many
+   * threads scan over one shared, read-only map.
+   *
+   * @param overlay The scanned plane to update. Must match the map's size.
+   * @param firstRow The first row of the rectangle (inclusive).
+   * @param firstCol The first column of the rectangle (inclusive).
+   * @param lastRow The last row of the rectangle (inclusive).
+   * @param lastCol The last column of the rectangle (inclusive).
+   * @param newCells If not nullptr, receives the <row, column> of every Cell
+   * newly marked in the overlay.
+   *
+   * @return The number of Cells newly marked in the overlay.
+   */
+  int scanAreaInto(BitGrid &overlay, int firstRow, int firstCol, int lastRow,
+                   int lastCol,
+                   std::vector<std::pair<int, int>> *newCells = nullptr) const;
+  /*
+   * @brief Getter for the bit-packed scanned plane, e.g. to seed an overlay.
+   *
+   * @return The scanned plane.
+   */
+  const BitGrid &getScannedPlane() const { return m_scannedBits; }
+
+  /*
+   * @brief Measures how far an aircraft can fly in a straight line, using word
+   * operations on the packed traversable planes.
+   *
+   * @param row The row the run starts from.
+   * @param col The column the run starts from.
+   * @param dRow The row step of each move (-1, 0 or 1).
+   * @param dCol The column step of each move (-1, 0 or 1).
+   * @param limit The longest run of interest.
+   *
+   * @return The number of consecutive traversable Cells after (row, col) in
+   * the given direction, capped at limit.
+   */
+  int openRunLength(int row, int col, int dRow, int dCol, int limit) const;
+  /*
+   * @brief Looks along a straight line for the first Cell beside which a
+   * passage opens: a traversable Cell on either side that follows an
+   * untraversable one (or the map edge) on that side. Uses the same packed
+   * planes as openRunLength().
+   *
+   * @param row The row the line starts from.
+   * @param col The column the line starts from.
+   * @param dRow The row step along the line (-1, 0 or 1).
+   * @param dCol The column step along the line (-1, 0 or 1).
+   * @param limit The number of Cells after (row, col) to examine.
+   *
+   * @return The number of steps to the first such Cell, or 0 if there is none
+   * within limit.
+   */
+  int sideOpeningDistance(int row, int col, int dRow, int dCol,
+                          int limit) const;
+
+  /*
+   * @brief Builds a table holding, for every Cell and each of the four
+   * headings, the number of new Cells a scan from that pose would cover.
+   *
+   * Once built, every scan, markScanned() and markUntraversable() decrements
+   * only the entries whose footprints cover the changed Cell, so
+   * tableGain() stays exact in O(1).
+   *
+   * @param footprints The scanner rectangle for each heading, as
+   * {firstRow, firstCol, lastRow, lastCol} offsets from the pose.
+   *
+   * @return Nothing.
+   */
+  void buildGainTable(const std::array<std::array<int, 4>, 4> &footprints);
+  /*
+   * @brief Determines if buildGainTable() has been called.
+   *
+   * @return True if tableGain() may be used, else false.
+   */
+  bool hasGainTable() const { return !m_gainTable.empty(); }
+  /*
+   * @brief Reads the gain table. Requires hasGainTable().
+   *
+   * @param row The row of the pose.
+   * @param col The column of the pose.
+   * @param heading The heading of the pose (0-3).
+   *
+   * @return The number of new Cells a scan from the pose would cover.
+   */
+  int tableGain(int row, int col, int heading) const {
+    return m_gainTable[gainIndex(row, col, heading)];
+  }
+
   /*
    * @breif Marks a Cell as colored.
    *
@@ -82,9 +209,7 @@ public:
    *
    * @return Nothing.
    */
-  void markUntraversable(int row, int column) {
-    m_grid[row][column].traversable = false;
-  }
+  void markUntraversable(int row, int column);
 
   /*
    * @brief Determines if a Cell is colored.
@@ -107,6 +232,21 @@ public:
    * @return True if the position is valid, else false.
    */
   bool isWithinBounds(int row, int col) const;
+  /*
+   * @brief Determines if an aircraft may stand on a position: the position is
+   * on the map and the Cell there is traversable.
+   *
+   * @note Unlike isTraversable() this never asserts or prints, so it is safe
+   * to call on any candidate position in a hot loop.
+   *
+   * @param row The row (y coordinate) being examined.
+   * @param col The column (x coordinate) being examined.
+   *
+   * @return True if the position is on the map and traversable, else false.
+   */
+  bool canOccupy(int row, int col) const {
+    return isWithinBounds(row, col) && m_traversableBits.test(row, col);
+  }
   /*
    * @brief Prints the grid map to the terminal.
    *
@@ -155,6 +295,27 @@ private:
   int m_colCount = 0;                    // 1-indexed grid column count
   int m_rowCount = 0;                    // 1-indexed grid row count
   int m_totalTraversable = 0; // The total number of traversable Cells
+  BitGrid m_traversableBits;  // Bit-packed copy of Cell::traversable
+  BitGrid m_traversableCols;  // Transpose of m_traversableBits
+  BitGrid m_scannedBits;      // Bit-packed scanned state of every Cell
+  std::array<std::array<int, 4>, 4> m_footprints{}; // Gain table footprints
+  std::vector<std::uint8_t> m_gainTable; // Per (Cell, heading) scan gain
+
+  // Position of a (Cell, heading) entry in m_gainTable
+  std::size_t gainIndex(int row, int col, int heading) const {
+    return (static_cast<std::size_t>(row) * m_colCount + col) * 4 + heading;
+  }
+
+  /*
+   * @brief Decrements the gain table entries whose footprints cover a Cell
+   * that just stopped counting as new.
+   *
+   * @param row The row of the Cell.
+   * @param column The column of the Cell.
+   *
+   * @return Nothing.
+   */
+  void discountGain(int row, int column);
 };
 
 #endif
@@ -0,0 +1,638 @@
+#include "optimizer.h"
+#include "map.h"
+#include "planner.h"
+#include "replay.h"
+#include "search.h"
+#include "state.h"
+#include "threadpool.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Windows re-planned per round of improveRoute(); fixed, so that the route
+// found does not depend on the number of threads
+constexpr int WINDOWS_PER_ROUND = 16;
+// Shortest and longest windows, in moves
+constexpr int MIN_WINDOW = 8;
+constexpr int MAX_WINDOW = 48;
+// Cells a re-planned window may stray beyond the poses it replaces; more
+// than the reach of a scan, so every Cell the window scanned is inside
+constexpr int WINDOW_MARGIN = 3;
+// Largest random factor on a walk target's score, so ties break differently
+constexpr double SCORE_NOISE = 0.25;
+
+// One window of a route and its re-planned moves
+struct Rewrite {
+  int first = 0;            // Index of the pose the window starts from
+  int last = 0;             // Index of the pose the window ends at
+  unsigned seed = 0;        // Seeds the walk's tie-breaking
+  std::vector<Moves> moves; // The re-planned moves
+  int saved = 0;            // Moves saved; 0 if the window was not improved
+};
+
+/*
+ * @brief Helper function for optimizeRoute() and improveRoute(). Adds a
+ * pose's scan to the count of poses scanning each Cell, or takes it away.
+ *
+ * @param map The GridMap the route is flown over. Cells it has already
+ * scanned are not counted.
+ * @param counts The number of poses scanning each Cell, as row * columns +
+ * column.
+ * @param state The pose.
+ * @param delta 1 to add the scan, -1 to take it away.
+ *
+ * @return Nothing.
+ */
+void tallyScan(const GridMap &map, std::vector<int> &counts,
+               const AircraftState &state, const int delta) {
+  const std::array<int, 4> area = scanFootprint(state);
+  for (int row = area[0]; row <= area[2]; row++) {
+    for (int col = area[1]; col <= area[3]; col++) {
+      if (map.canOccupy(row, col) && !map.isScanned(row, col)) {
+        counts[row * map.getColCount() + col] += delta;
+      }
+    }
+  }
+}
+
+/*
+ * @brief Helper function for optimizeRoute(). Checks whether a pose's scan
+ * is the only one left of some Cell.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param counts The number of poses scanning each Cell.
+ * @param state The pose, whose scan has already been taken away.
+ *
+ * @return True if a Cell it scans is no longer scanned by any pose.
+ */
+bool scansLostCell(const GridMap &map, const std::vector<int> &counts,
+                   const AircraftState &state) {
+  const std::array<int, 4> area = scanFootprint(state);
+  for (int row = area[0]; row <= area[2]; row++) {
+    for (int col = area[1]; col <= area[3]; col++) {
+      if (map.canOccupy(row, col) && !map.isScanned(row, col) &&
+          counts[row * map.getColCount() + col] == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/*
+ * @brief Helper function for optimizeRoute(). Replaces the moves between two
+ * poses of a route in the scan counts, unless that loses a Cell.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param counts The number of poses scanning each Cell. Left as it was if
+ * the rewrite is refused.
+ * @param poses The pose after each move of the route, starting with the
+ * start pose.
+ * @param first The index of the pose the replaced moves start from.
+ * @param last The index of the pose they end at. The replacement must end
+ * there too.
+ * @param replacement The new moves.
+ *
+ * @return True if the rewrite was kept, else false.
+ */
+bool tryRewrite(const GridMap &map, std::vector<int> &counts,
+                const std::vector<AircraftState> &poses, const int first,
+                const int last, const std::vector<Moves> &replacement) {
+  std::vector<AircraftState> added;
+  AircraftState state = poses[first];
+  for (const Moves move : replacement) {
+    state = applyMove(state, move);
+    added.push_back(state);
+  }
+  for (int index = first + 1; index <= last; index++) {
+    tallyScan(map, counts, poses[index], -1);
+  }
+  for (const AircraftState &pose : added) {
+    tallyScan(map, counts, pose, 1);
+  }
+  bool lost = false;
+  for (int index = first + 1; !lost && index <= last; index++) {
+    lost = scansLostCell(map, counts, poses[index]);
+  }
+  if (lost) {
+    for (const AircraftState &pose : added) {
+      tallyScan(map, counts, pose, -1);
+    }
+    for (int index = first + 1; index <= last; index++) {
+      tallyScan(map, counts, poses[index], 1);
+    }
+  }
+  return !lost;
+}
+
+/*
+ * @brief Helper function for optimizeRoute() and improveRoute(). Lists the
+ * pose after each move of a route.
+ *
+ * @param start The pose the route starts from.
+ * @param moves The route.
+ *
+ * @return The start pose, then the pose after each move.
+ */
+std::vector<AircraftState> posesAlong(const AircraftState &start,
+                                      const std::vector<Moves> &moves) {
+  std::vector<AircraftState> poses = {start};
+  for (const Moves move : moves) {
+    poses.push_back(applyMove(poses.back(), move));
+  }
+  return poses;
+}
+
+/*
+ * @brief Helper function for optimizeRoute(). Drops the moves after the last
+ * one that scans a new Cell.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param start The pose the route starts from.
+ * @param moves The route. Updated in place.
+ * @param counts The number of poses scanning each Cell. Updated in place.
+ *
+ * @return True if the route changed, else false.
+ */
+bool trimTail(const GridMap &map, const AircraftState &start,
+              std::vector<Moves> &moves, std::vector<int> &counts) {
+  const ReplayResult replay = replayRoute(map, start, moves);
+  std::size_t keep = moves.size();
+  while (keep > 0 && replay.stepGains[keep - 1] == 0) {
+    keep--;
+    tallyScan(map, counts, replay.states[keep], -1);
+  }
+  if (keep == moves.size()) {
+    return false;
+  }
+  moves.resize(keep);
+  return true;
+}
+
+/*
+ * @brief Helper function for optimizeRoute(). Replaces every run of turns
+ * with the fewest turns to the same heading.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param start The pose the route starts from.
+ * @param moves The route. Updated in place.
+ * @param counts The number of poses scanning each Cell. Updated in place.
+ *
+ * @return True if the route changed, else false.
+ */
+bool mergeTurns(const GridMap &map, const AircraftState &start,
+                std::vector<Moves> &moves, std::vector<int> &counts) {
+  const std::vector<AircraftState> poses = posesAlong(start, moves);
+  const int moveCount = static_cast<int>(moves.size());
+  std::vector<Moves> merged;
+  bool changed = false;
+  int first = 0;
+  while (first < moveCount) {
+    if (moves[first] == Moves::move_FORWARD) {
+      merged.push_back(moves[first++]);
+      continue;
+    }
+    int last = first;
+    while (last < moveCount && moves[last] != Moves::move_FORWARD) {
+      last++;
+    }
+    std::vector<Moves> best(moves.begin() + first, moves.begin() + last);
+    // An about-face can turn either way; which one scans more can matter
+    std::vector<std::vector<Moves>> candidates = {
+        turnsBetween(poses[first].dir, poses[last].dir)};
+    if (candidates.front().size() == 2) {
+      candidates.push_back({Moves::move_TURNLEFT, Moves::move_TURNLEFT});
+    }
+    for (const std::vector<Moves> &candidate : candidates) {
+      if (candidate.size() < best.size() &&
+          tryRewrite(map, counts, poses, first, last, candidate)) {
+        best = candidate;
+        changed = true;
+        break;
+      }
+    }
+    merged.insert(merged.end(), best.begin(), best.end());
+    first = last;
+  }
+  moves = merged;
+  return changed;
+}
+
+/*
+ * @brief Helper function for optimizeRoute(). Replaces every run of moves
+ * that scans nothing new with a shortest path between the poses it joins.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param start The pose the route starts from.
+ * @param moves The route. Updated in place.
+ * @param counts The number of poses scanning each Cell. Updated in place.
+ * @param workspace The buffers the searches run in.
+ *
+ * @return True if the route changed, else false.
+ */
+bool replanDetours(const GridMap &map, const AircraftState &start,
+                   std::vector<Moves> &moves, std::vector<int> &counts,
+                   SearchWorkspace &workspace) {
+  const ReplayResult replay = replayRoute(map, start, moves);
+  const std::vector<AircraftState> poses = posesAlong(start, moves);
+  const int moveCount = static_cast<int>(moves.size());
+  std::vector<Moves> replanned;
+  bool changed = false;
+  int first = 0;
+  while (first < moveCount) {
+    if (replay.stepGains[first] > 0) {
+      replanned.push_back(moves[first++]);
+      continue;
+    }
+    int last = first;
+    while (last < moveCount && replay.stepGains[last] == 0) {
+      last++;
+    }
+    std::vector<Moves> best(moves.begin() + first, moves.begin() + last);
+    const AircraftState from = poses[first];
+    const AircraftState to = poses[last];
+    const int length = last - first;
+    // No path is shorter than the distance plus a turn for a new heading
+    const int bound = std::abs(to.row - from.row) +
+                      std::abs(to.col - from.col) + (from.dir != to.dir);
+    if (last < moveCount && length > bound) {
+      std::vector<Moves> path;
+      if (!(from == to)) {
+        // A shorter path cannot leave this square around its start
+        const std::array<int, 4> area = {
+            std::max(from.row - length, 0), std::max(from.col - length, 0),
+            std::min(from.row + length, map.getRowCount() - 1),
+            std::min(from.col + length, map.getColCount() - 1)};
+        searchWithin(map, from, area, workspace);
+        path = pathFromSearch(map, from, to, workspace);
+      }
+      if (static_cast<int>(path.size()) < length &&
+          tryRewrite(map, counts, poses, first, last, path)) {
+        best = path;
+        changed = true;
+      }
+    }
+    replanned.insert(replanned.end(), best.begin(), best.end());
+    first = last;
+  }
+  moves = replanned;
+  return changed;
+}
+
+/*
+ * @brief Helper function for improveRoute(). Works out how many Cells a route
+ * gains or loses if the moves between two of its poses are replaced.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param counts The number of poses scanning each Cell. It is only read.
+ * @param poses The pose after each move of the route, starting with the
+ * start pose.
+ * @param first The index of the pose the replaced moves start from.
+ * @param last The index of the pose they end at.
+ * @param replacement The new moves.
+ *
+ * @return The change in the number of Cells the route scans.
+ */
+int coverageChange(const GridMap &map, const std::vector<int> &counts,
+                   const std::vector<AircraftState> &poses, const int first,
+                   const int last, const std::vector<Moves> &replacement) {
+  std::unordered_map<int, int> changes;
+  const auto tally = [&](const AircraftState &state, const int delta) {
+    const std::array<int, 4> area = scanFootprint(state);
+    for (int row = area[0]; row <= area[2]; row++) {
+      for (int col = area[1]; col <= area[3]; col++) {
+        if (map.canOccupy(row, col) && !map.isScanned(row, col)) {
+          changes[row * map.getColCount() + col] += delta;
+        }
+      }
+    }
+  };
+  for (int index = first + 1; index <= last; index++) {
+    tally(poses[index], -1);
+  }
+  AircraftState state = poses[first];
+  for (const Moves move : replacement) {
+    state = applyMove(state, move);
+    tally(state, 1);
+  }
+  int change = 0;
+  for (const auto &entry : changes) {
+    const bool before = counts[entry.first] > 0;
+    const bool after = counts[entry.first] + entry.second > 0;
+    change += static_cast<int>(after) - static_cast<int>(before);
+  }
+  return change;
+}
+
+/*
+ * @brief Helper function for improveRoute(). Re-plans one window of a route:
+ * a randomized greedy walk covers the Cells only the window scans, then
+ * flies back to the pose the window ended at.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param counts The number of poses scanning each Cell. It is only read.
+ * @param poses The pose after each move of the route, starting with the
+ * start pose.
+ * @param slack The number of Cells the route may lose.
+ * @param rewrite The window. Its moves and saving are filled in.
+ * @param workspace The buffers the searches run in.
+ *
+ * @return Nothing.
+ */
+void replanWindow(const GridMap &map, const std::vector<int> &counts,
+                  const std::vector<AircraftState> &poses, const int slack,
+                  Rewrite &rewrite, SearchWorkspace &workspace) {
+  rewrite.moves.clear();
+  rewrite.saved = 0;
+  const int length = rewrite.last - rewrite.first;
+  const bool routeEnd = rewrite.last == static_cast<int>(poses.size()) - 1;
+
+  // The walk stays near the poses it replaces
+  std::array<int, 4> area = {poses[rewrite.first].row,
+                             poses[rewrite.first].col,
+                             poses[rewrite.first].row,
+                             poses[rewrite.first].col};
+  for (int index = rewrite.first + 1; index <= rewrite.last; index++) {
+    area[0] = std::min<int>(area[0], poses[index].row);
+    area[1] = std::min<int>(area[1], poses[index].col);
+    area[2] = std::max<int>(area[2], poses[index].row);
+    area[3] = std::max<int>(area[3], poses[index].col);
+  }
+  area = {std::max(area[0] - WINDOW_MARGIN, 0),
+          std::max(area[1] - WINDOW_MARGIN, 0),
+          std::min(area[2] + WINDOW_MARGIN, map.getRowCount() - 1),
+          std::min(area[3] + WINDOW_MARGIN, map.getColCount() - 1)};
+  const int width = area[3] - area[1] + 1;
+
+  // The Cells no pose outside the window scans
+  std::unordered_map<int, int> hits;
+  for (int index = rewrite.first + 1; index <= rewrite.last; index++) {
+    const std::array<int, 4> scan = scanFootprint(poses[index]);
+    for (int row = scan[0]; row <= scan[2]; row++) {
+      for (int col = scan[1]; col <= scan[3]; col++) {
+        if (map.canOccupy(row, col) && !map.isScanned(row, col)) {
+          hits[row * map.getColCount() + col]++;
+        }
+      }
+    }
+  }
+  std::vector<char> uncovered(
+      static_cast<std::size_t>(area[2] - area[0] + 1) * width, 0);
+  int remaining = 0;
+  for (const auto &entry : hits) {
+    if (counts[entry.first] == entry.second) {
+      const int row = entry.first / map.getColCount();
+      const int col = entry.first % map.getColCount();
+      uncovered[(row - area[0]) * width + (col - area[1])] = 1;
+      remaining++;
+    }
+  }
+  // Counts a pose's uncovered Cells, clearing them if asked
+  const auto coverFrom = [&](const AircraftState &state, const bool clear) {
+    const std::array<int, 4> scan = scanFootprint(state);
+    int gain = 0;
+    for (int row = std::max(scan[0], area[0]);
+         row <= std::min(scan[2], area[2]); row++) {
+      for (int col = std::max(scan[1], area[1]);
+           col <= std::min(scan[3], area[3]); col++) {
+        char &cell = uncovered[(row - area[0]) * width + (col - area[1])];
+        gain += cell;
+        if (clear) {
+          cell = 0;
+        }
+      }
+    }
+    return gain;
+  };
+
+  std::mt19937 random(rewrite.seed);
+  std::uniform_real_distribution<double> noise(1.0, 1.0 + SCORE_NOISE);
+  AircraftState state = poses[rewrite.first];
+  std::vector<Moves> moves;
+  while (remaining > 0 && static_cast<int>(moves.size()) < length) {
+    // Head for the reachable pose that covers the most per move
+    searchWithin(map, state, area, workspace);
+    double bestScore = 0.0;
+    AircraftState target = state;
+    for (int row = area[0]; row <= area[2]; row++) {
+      for (int col = area[1]; col <= area[3]; col++) {
+        for (int dir = 0; dir < 4 && map.canOccupy(row, col); dir++) {
+          const AircraftState pose =
+              makeState(row, col, static_cast<Direction>(dir));
+          const int id = stateId(map, pose);
+          if (!workspace.isVisited(id) || workspace.getCost(id) == 0) {
+            continue;
+          }
+          const int gain = coverFrom(pose, false);
+          if (gain == 0) {
+            continue;
+          }
+          const double score =
+              gain * noise(random) / static_cast<double>(workspace.getCost(id));
+          if (score > bestScore) {
+            bestScore = score;
+            target = pose;
+          }
+        }
+      }
+    }
+    if (target == state) {
+      break;
+    }
+    for (const Moves move : pathFromSearch(map, state, target, workspace)) {
+      state = applyMove(state, move);
+      remaining -= coverFrom(state, true);
+      moves.push_back(move);
+    }
+  }
+
+  // Rejoin the rest of the route
+  if (!routeEnd && !(state == poses[rewrite.last]) &&
+      static_cast<int>(moves.size()) < length) {
+    searchWithin(map, state, area, workspace);
+    const std::vector<Moves> back =
+        pathFromSearch(map, state, poses[rewrite.last], workspace);
+    if (back.empty()) {
+      return;
+    }
+    moves.insert(moves.end(), back.begin(), back.end());
+  }
+  if (static_cast<int>(moves.size()) >= length ||
+      coverageChange(map, counts, poses, rewrite.first, rewrite.last, moves) <
+          -slack) {
+    return;
+  }
+  rewrite.saved = length - static_cast<int>(moves.size());
+  rewrite.moves = std::move(moves);
+}
+
+} // namespace
+
+std::vector<Moves> optimizeRoute(const GridMap &map, const AircraftState &start,
+                                 const std::vector<Moves> &route) {
+  const ReplayResult original = replayRoute(map, start, route);
+  if (!original.valid) {
+    return route;
+  }
+
+  std::vector<int> counts(
+      static_cast<std::size_t>(map.getRowCount()) * map.getColCount(), 0);
+  tallyScan(map, counts, start, 1);
+  for (const AircraftState &state : original.states) {
+    tallyScan(map, counts, state, 1);
+  }
+
+  // Every rewrite shortens the route, so this ends
+  std::vector<Moves> moves = route;
+  SearchWorkspace workspace;
+  bool changed = true;
+  while (changed) {
+    changed = trimTail(map, start, moves, counts);
+    changed = mergeTurns(map, start, moves, counts) || changed;
+    changed = replanDetours(map, start, moves, counts, workspace) || changed;
+  }
+
+  const ReplayResult optimized = replayRoute(map, start, moves);
+  if (!optimized.valid || optimized.scannedCount < original.scannedCount) {
+    std::cerr << "The optimized route lost coverage. Keeping the original.\n";
+    return route;
+  }
+  return moves;
+}
+
+ImproveResult improveRoute(const GridMap &map, const AircraftState &start,
+                           const std::vector<Moves> &route,
+                           const float searchPercentage, int roundLimit,
+                           const int threadCount, const unsigned seed,
+                           const CancelToken &token) {
+  ImproveResult result;
+  result.moves = route;
+  if (roundLimit < 1) {
+    std::cerr << "roundLimit must be greater than 0. Updating value to 1.\n";
+    roundLimit = 1;
+  }
+  const ReplayResult replay = replayRoute(map, start, route);
+  if (!replay.valid) {
+    return result;
+  }
+  const float target = clampSearchPercentage(searchPercentage);
+  const int required = std::min(
+      replay.scannedCount,
+      static_cast<int>(std::ceil(
+          target * static_cast<float>(map.getTraversableCount()))));
+
+  std::vector<int> counts(
+      static_cast<std::size_t>(map.getRowCount()) * map.getColCount(), 0);
+  tallyScan(map, counts, start, 1);
+  for (const AircraftState &state : replay.states) {
+    tallyScan(map, counts, state, 1);
+  }
+  int scanned = replay.scannedCount;
+
+  ThreadPool pool(threadCount);
+  const int threads = pool.getThreadCount();
+  std::vector<SearchWorkspace> workspaces(threads);
+  std::vector<Rewrite> rewrites(WINDOWS_PER_ROUND);
+  std::mt19937 random(seed);
+  for (; result.rounds < roundLimit; result.rounds++) {
+    if (token.stopRequested()) {
+      result.interrupted = true;
+      break;
+    }
+    const std::vector<AircraftState> poses = posesAlong(start, result.moves);
+    const int moveCount = static_cast<int>(result.moves.size());
+    if (moveCount < MIN_WINDOW) {
+      break;
+    }
+    std::uniform_int_distribution<int> firstMove(0, moveCount - MIN_WINDOW);
+    std::uniform_int_distribution<int> windowLength(MIN_WINDOW, MAX_WINDOW);
+    for (Rewrite &rewrite : rewrites) {
+      rewrite.first = firstMove(random);
+      rewrite.last = std::min(rewrite.first + windowLength(random), moveCount);
+      rewrite.seed = random();
+    }
+
+    // Each thread re-plans every threads-th window in its own workspace
+    const int slack = scanned - required;
+    pool.parallelFor(threads, [&](const int task) {
+      for (int index = task; index < static_cast<int>(rewrites.size());
+           index += threads) {
+        rewrites[index].saved = 0;
+        if (!token.stopRequested()) {
+          replanWindow(map, counts, poses, slack, rewrites[index],
+                       workspaces[task]);
+        }
+      }
+    });
+
+    // Apply the biggest savings first, skipping windows that overlap them
+    std::vector<int> order(rewrites.size());
+    for (int index = 0; index < static_cast<int>(order.size()); index++) {
+      order[index] = index;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+      return rewrites[a].saved > rewrites[b].saved;
+    });
+    std::vector<const Rewrite *> kept;
+    for (const int index : order) {
+      const Rewrite &rewrite = rewrites[index];
+      if (rewrite.saved == 0) {
+        break;
+      }
+      const bool overlaps =
+          std::any_of(kept.begin(), kept.end(), [&](const Rewrite *other) {
+            return rewrite.first < other->last && other->first < rewrite.last;
+          });
+      if (overlaps) {
+        continue;
+      }
+      // Windows kept earlier this round may have taken the slack
+      const int change = coverageChange(map, counts, poses, rewrite.first,
+                                        rewrite.last, rewrite.moves);
+      if (scanned + change < required) {
+        continue;
+      }
+      for (int pose = rewrite.first + 1; pose <= rewrite.last; pose++) {
+        tallyScan(map, counts, poses[pose], -1);
+      }
+      AircraftState state = poses[rewrite.first];
+      for (const Moves move : rewrite.moves) {
+        state = applyMove(state, move);
+        tallyScan(map, counts, state, 1);
+      }
+      scanned += change;
+      kept.push_back(&rewrite);
+    }
+    if (kept.empty()) {
+      continue;
+    }
+
+    std::sort(kept.begin(), kept.end(), [](const Rewrite *a, const Rewrite *b) {
+      return a->first < b->first;
+    });
+    std::vector<Moves> improved;
+    int next = 0;
+    for (const Rewrite *rewrite : kept) {
+      improved.insert(improved.end(), result.moves.begin() + next,
+                      result.moves.begin() + rewrite->first);
+      improved.insert(improved.end(), rewrite->moves.begin(),
+                      rewrite->moves.end());
+      next = rewrite->last;
+    }
+    improved.insert(improved.end(), result.moves.begin() + next,
+                    result.moves.end());
+    result.moves = std::move(improved);
+    result.windowsKept += static_cast<int>(kept.size());
+  }
+  return result;
+}
@@ -0,0 +1,80 @@
+#ifndef OPTIMIZER
+#define OPTIMIZER
+
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include <vector>
+
+/*
+ * @brief A route improved by improveRoute() and how the search went.
+ */
+struct ImproveResult {
+  std::vector<Moves> moves; // The improved route
+  int rounds = 0;           // Rounds of windows re-planned
+  int windowsKept = 0;      // Re-planned windows that replaced the old moves
+  bool interrupted = false; // True if the token stopped it before roundLimit
+};
+
+/*
+ * @brief Shortens a planned route without losing any of its coverage. Works
+ * on the output of every planner.
+ *
+ * The route is rewritten until none of these rules applies:
+ *  - A run of turns is replaced by the fewest turns to the same heading, so
+ *    three left turns become one right turn and a turn and its opposite
+ *    cancel.
+ *  - A run of moves that scans nothing new, such as a repositioning leg, is
+ *    replaced by a shortest path between the poses it joins.
+ *  - Moves after the last one that scans anything new are dropped.
+ * A rewrite is only kept if every Cell the moves it removes scanned is still
+ * scanned by another pose of the route. The result is replayed and checked
+ * against the original before it is returned.
+ *
+ * @param map The GridMap the route was planned on. It is not modified.
+ * @param start The pose the route starts from.
+ * @param route The route. Routes with an illegal move are returned unchanged.
+ *
+ * @return The shortened route. It is legal and scans every Cell the original
+ * scans.
+ */
+std::vector<Moves> optimizeRoute(const GridMap &map, const AircraftState &start,
+                                 const std::vector<Moves> &route);
+
+/*
+ * @brief Shortens a planned route by large-neighbourhood search, for as long
+ * as it is allowed to run.
+ *
+ * Each round picks random windows of the route and re-plans them on a
+ * ThreadPool. A window's Cells that no other pose of the route scans are
+ * covered again by a randomized greedy walk, whose legs are shortest paths
+ * inside the area around the window, and then the walk flies back to the
+ * pose the window ended at. Workers only read the round's per-Cell scan
+ * counts, so windows are re-planned concurrently. The shortened windows
+ * that do not overlap are then applied, best first, as long as the route
+ * still scans as many Cells as it has to. Every round leaves a complete
+ * route, so stopping at any time keeps the improvements so far.
+ *
+ * @param map The GridMap the route was planned on. It is not modified.
+ * @param start The pose the route starts from.
+ * @param route The route. Routes with an illegal move are returned unchanged.
+ * @param searchPercentage The fraction of traversable Cells to scan, clamped
+ * to [0.01, 1]. The route keeps scanning at least this many Cells, or as
+ * many as it did if that is fewer.
+ * @param roundLimit The number of rounds to run. Bounds checking ensures
+ * roundLimit >= 1.
+ * @param threadCount The number of threads re-planning windows; values
+ * below 1 use every hardware thread. The result does not depend on it.
+ * @param seed Seeds the choice of windows and the walks' tie-breaking.
+ * @param token Stops the search after the round under way, such as when a
+ * deadline passes.
+ *
+ * @return The shortened route and statistics about the search.
+ */
+ImproveResult improveRoute(const GridMap &map, const AircraftState &start,
+                           const std::vector<Moves> &route,
+                           float searchPercentage, int roundLimit,
+                           int threadCount = 0, unsigned seed = 1,
+                           const CancelToken &token = CancelToken());
+
+#endif
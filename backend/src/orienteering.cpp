@@ -0,0 +1,198 @@
+#include "orienteering.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "routebuilder.h"
+#include "search.h"
+#include "state.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+// Radius of the first area searched around the aircraft
+constexpr int FIRST_RADIUS = 4;
+// Longest straight run a leg may end with
+constexpr int MAX_RUN = 32;
+
+// Cells of one scan, and Cells a forward move adds to the previous scan
+constexpr int SCAN_CELLS =
+    (motion::FOOTPRINT[0][2] - motion::FOOTPRINT[0][0] + 1) *
+    (motion::FOOTPRINT[0][3] - motion::FOOTPRINT[0][1] + 1);
+constexpr int EDGE_CELLS =
+    motion::FOOTPRINT[0][3] - motion::FOOTPRINT[0][1] + 1;
+
+// A candidate leg: a path to a pose, then a straight run from it
+struct Leg {
+  AircraftState target{}; // Pose the path ends at
+  int moves = 0;          // Moves of the path and the run together
+  int run = 0;            // Forward moves after the path
+  int gain = 0;           // New Cells the scans along the way add
+};
+
+/*
+ * @brief Helper function for OrienteeringPlanner's findRoute(). Ranks two
+ * legs by new Cells per move.
+ *
+ * @param gain The new Cells of one leg.
+ * @param moves The moves of that leg. Must be at least 1.
+ * @param best The other leg.
+ *
+ * @return True if the first leg gains strictly more per move, or as much per
+ * move and more in total, else false. Any leg that gains outranks an empty
+ * best.
+ */
+bool outranks(const int gain, const int moves, const Leg &best) {
+  if (best.gain == 0) {
+    return gain > 0;
+  }
+  // gain / moves > best.gain / best.moves, without dividing
+  const int lhs = gain * best.moves;
+  const int rhs = best.gain * moves;
+  return lhs > rhs || (lhs == rhs && gain > best.gain);
+}
+
+/*
+ * @brief Helper function for OrienteeringPlanner's findRoute(). Determines if
+ * a leg to a pose at least some distance away could outrank the best one.
+ *
+ * A leg's first scan adds at most SCAN_CELLS and each forward move of its
+ * run at most EDGE_CELLS, so its Cells per move peak either with no run or
+ * with the longest one.
+ *
+ * @param distance The fewest moves to the leg's target.
+ * @param best The best leg so far.
+ *
+ * @return True if some leg that far away might outrank best, else false.
+ */
+bool mightOutrank(const int distance, const Leg &best) {
+  return outranks(SCAN_CELLS, distance, best) ||
+         outranks(SCAN_CELLS + EDGE_CELLS * MAX_RUN, distance + MAX_RUN, best);
+}
+
+/*
+ * @brief Helper function for OrienteeringPlanner's findRoute(). The Cells a
+ * forward move to a pose adds to the scan of the pose behind it.
+ *
+ * @param state The pose after the move.
+ *
+ * @return The inclusive {firstRow, firstCol, lastRow, lastCol} row or column
+ * of the footprint furthest ahead.
+ */
+std::array<int, 4> leadingEdge(const AircraftState &state) {
+  std::array<int, 4> edge = scanFootprint(state);
+  const int dir = static_cast<int>(state.dir);
+  if (motion::FORWARD_ROW[dir] < 0) {
+    edge[2] = edge[0];
+  } else if (motion::FORWARD_ROW[dir] > 0) {
+    edge[0] = edge[2];
+  } else if (motion::FORWARD_COL[dir] > 0) {
+    edge[1] = edge[3];
+  } else {
+    edge[3] = edge[1];
+  }
+  return edge;
+}
+
+/*
+ * @brief Helper function for OrienteeringPlanner's findRoute(). Finds the
+ * best leg ending at a pose reached by the last searchWithin() run.
+ *
+ * @param map The GridMap being scanned.
+ * @param state The pose the path ends at.
+ * @param distance The moves of the path.
+ * @param budget The moves left for the path and the run together.
+ * @param best The best leg so far. Replaced if a leg from state outranks it.
+ *
+ * @return Nothing.
+ */
+void considerLegs(const GridMap &map, const AircraftState &state,
+                  const int distance, const int budget, Leg &best) {
+  // The aircraft's own pose has already scanned
+  int gain = distance > 0 ? footprintGain(map, state) : 0;
+  if (gain > 0 && outranks(gain, distance, best)) {
+    best = {state, distance, 0, gain};
+  }
+  const int runLimit =
+      forwardRunLength(map, state, std::min(MAX_RUN, budget - distance));
+  for (int run = 1; run <= runLimit; run++) {
+    // A run is only worth extending while its scans keep paying off. The
+    // leading edge is part of the footprint, whose gain is a cheap lookup
+    const AircraftState ahead = advancedBy(state, run);
+    if (footprintGain(map, ahead) == 0) {
+      break;
+    }
+    const std::array<int, 4> edge = leadingEdge(ahead);
+    const int edgeGain = map.scanAreaGain(edge[0], edge[1], edge[2], edge[3]);
+    if (edgeGain == 0) {
+      break;
+    }
+    gain += edgeGain;
+    if (outranks(gain, distance + run, best)) {
+      best = {state, distance + run, run, gain};
+    }
+  }
+}
+
+} // namespace
+
+OrienteeringPlanner::OrienteeringPlanner(Aircraft aircraft,
+                                         float searchPercentage,
+                                         int moveLimit)
+    : m_aircraft(aircraft), m_moveLimit(clampMoveLimit(moveLimit)),
+      m_searchPercentage(clampSearchPercentage(searchPercentage)) {}
+
+std::vector<Moves> OrienteeringPlanner::findRoute(const CancelToken &token) {
+  RouteBuilder route(m_aircraft, m_searchPercentage, m_moveLimit, token);
+  SearchWorkspace workspace;
+  workspace.setCancelToken(token);
+  const GridMap &map = route.getMap();
+  const int lastRow = map.getRowCount() - 1;
+  const int lastCol = map.getColCount() - 1;
+
+  while (route.routing()) {
+    const AircraftState start = route.getState();
+    const int budget = m_moveLimit - static_cast<int>(route.getMoves().size());
+
+    // Widen the search until no pose outside it can beat the best leg inside,
+    // or it holds every pose the budget reaches
+    Leg best;
+    for (int radius = FIRST_RADIUS;; radius *= 2) {
+      const std::array<int, 4> area = {
+          std::max(0, start.row - radius), std::max(0, start.col - radius),
+          std::min(lastRow, start.row + radius),
+          std::min(lastCol, start.col + radius)};
+      searchWithin(map, start, area, workspace);
+      best = Leg();
+      for (int row = area[0]; row <= area[2]; row++) {
+        for (int col = area[1]; col <= area[3]; col++) {
+          for (int dir = 0; dir < 4; dir++) {
+            const AircraftState state =
+                makeState(row, col, static_cast<Direction>(dir));
+            const int id = stateId(map, state);
+            if (workspace.isVisited(id) && workspace.getCost(id) < budget) {
+              considerLegs(map, state, workspace.getCost(id), budget, best);
+            }
+          }
+        }
+      }
+      const bool wholeMap = area[0] == 0 && area[1] == 0 &&
+                            area[2] == lastRow && area[3] == lastCol;
+      if (wholeMap || radius >= budget || token.stopRequested() ||
+          (best.gain > 0 && !mightOutrank(radius + 1, best))) {
+        break;
+      }
+    }
+
+    // Nothing the budget reaches scans anything new
+    if (best.gain == 0) {
+      break;
+    }
+    route.fly(pathFromSearch(map, start, best.target, workspace));
+    route.flyStraight(best.run);
+  }
+  return route.getMoves();
+}
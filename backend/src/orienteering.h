@@ -0,0 +1,55 @@
+#ifndef ORIENTEERING
+#define ORIENTEERING
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "state.h"
+#include <vector>
+
+/*
+ * @brief A coverage planner for move budgets too tight to reach the coverage
+ * target, which tries to scan as many Cells as the budget allows.
+ *
+ * The route is built from legs: a shortest path to some pose, then a
+ * straight run from it. Before every leg the planner measures the distance
+ * to every pose around the aircraft, drops the poses the remaining budget
+ * cannot reach, and flies the leg with the most new Cells per move. The area
+ * searched starts small and doubles only while a pose further out could
+ * still gain more per move than the best leg found, so the usual leg costs
+ * a search of a few dozen poses. Unlike RoutePlanner, the aircraft never
+ * flies back for a single Cell while richer ground is as close.
+ */
+class OrienteeringPlanner {
+public:
+  /*
+   * @brief Constructor for the OrienteeringPlanner class.
+   *
+   * @param aircraft The Aircraft being routed.
+   * @param searchPercentage The percentage of traversable cells to be searched
+   * for completion. Bounds checking ensures 0.01 <= searchPercentage <= 1.
+   * @param moveLimit The number of moves the Aircraft is allowed to make.
+   * Bounds checking ensures moveLimit >= 1.
+   *
+   * @return Nothing.
+   */
+  OrienteeringPlanner(Aircraft aircraft, float searchPercentage,
+                      int moveLimit);
+
+  /*
+   * @brief Plans the route. Stops as soon as the coverage target is met, the
+   * move limit is reached, no reachable pose scans anything new or the
+   * CancelToken asks it to stop.
+   *
+   * @param token Stops planning early, keeping the moves so far.
+   *
+   * @return The moves, in order.
+   */
+  std::vector<Moves> findRoute(const CancelToken &token = CancelToken());
+
+private:
+  Aircraft m_aircraft;            // The aircraft being routed
+  int m_moveLimit = 0;            // Moves the aircraft may use
+  float m_searchPercentage = 0.0; // Fraction of Cells to scan
+};
+
+#endif
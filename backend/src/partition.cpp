@@ -0,0 +1,264 @@
+#include "partition.h"
+#include "map.h"
+#include "state.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for RegionPartition. Measures the number of steps
+ * from the nearest of several Cells to every Cell.
+ *
+ * @param map The GridMap being split.
+ * @param sources The Cells the search starts from (row * columns + column).
+ *
+ * @return The distance to each Cell, -1 where none of the sources reaches.
+ */
+std::vector<int> cellDistances(const GridMap &map,
+                               const std::vector<int> &sources) {
+  const int cols = map.getColCount();
+  std::vector<int> distances(
+      static_cast<std::size_t>(map.getRowCount()) * cols, -1);
+  std::vector<int> queue;
+  for (const int cell : sources) {
+    if (distances[cell] < 0) {
+      distances[cell] = 0;
+      queue.push_back(cell);
+    }
+  }
+  // Turns happen in place, so any traversable neighbour is one step away
+  for (std::size_t head = 0; head < queue.size(); head++) {
+    const int cell = queue[head];
+    for (int dir = 0; dir < 4; dir++) {
+      const int row = cell / cols + motion::FORWARD_ROW[dir];
+      const int col = cell % cols + motion::FORWARD_COL[dir];
+      if (map.canOccupy(row, col) && distances[row * cols + col] < 0) {
+        distances[row * cols + col] = distances[cell] + 1;
+        queue.push_back(row * cols + col);
+      }
+    }
+  }
+  return distances;
+}
+
+/*
+ * @brief Helper function for RegionPartition. Grows one region from each
+ * seed, always extending the smallest region that can still grow.
+ *
+ * @param map The GridMap being split.
+ * @param seeds One distinct traversable Cell per region.
+ * @param regions Set to the region of each Cell, -1 for none.
+ * @param sizes Set to the number of Cells in each region.
+ *
+ * @return Nothing.
+ */
+void growRegions(const GridMap &map, const std::vector<int> &seeds,
+                 std::vector<int> &regions, std::vector<int> &sizes) {
+  const int cols = map.getColCount();
+  const int regionCount = static_cast<int>(seeds.size());
+  regions.assign(static_cast<std::size_t>(map.getRowCount()) * cols, -1);
+  sizes.assign(regionCount, 1);
+
+  // Each region keeps its own breadth-first frontier
+  std::vector<std::vector<int>> frontiers(regionCount);
+  std::vector<std::size_t> heads(regionCount, 0);
+  using Entry = std::pair<int, int>; // {size, region}
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> smallest;
+  for (int region = 0; region < regionCount; region++) {
+    regions[seeds[region]] = region;
+    frontiers[region].push_back(seeds[region]);
+    smallest.emplace(1, region);
+  }
+
+  while (!smallest.empty()) {
+    const int region = smallest.top().second;
+    smallest.pop();
+    // Expand frontier Cells until one claims a neighbour
+    std::vector<int> &frontier = frontiers[region];
+    bool grew = false;
+    while (!grew && heads[region] < frontier.size()) {
+      const int cell = frontier[heads[region]++];
+      for (int dir = 0; dir < 4; dir++) {
+        const int row = cell / cols + motion::FORWARD_ROW[dir];
+        const int col = cell % cols + motion::FORWARD_COL[dir];
+        if (map.canOccupy(row, col) && regions[row * cols + col] < 0) {
+          regions[row * cols + col] = region;
+          frontier.push_back(row * cols + col);
+          sizes[region]++;
+          grew = true;
+        }
+      }
+    }
+    if (heads[region] < frontier.size()) {
+      smallest.emplace(sizes[region], region);
+    }
+  }
+}
+
+/*
+ * @brief Helper function for RegionPartition. Finds the Cell of each region
+ * closest to the region's centroid.
+ *
+ * @param regions The region of each Cell.
+ * @param cols The number of columns.
+ * @param regionCount The number of regions.
+ *
+ * @return One Cell per region.
+ */
+std::vector<int> regionCentres(const std::vector<int> &regions, const int cols,
+                               const int regionCount) {
+  std::vector<double> rowSums(regionCount, 0.0);
+  std::vector<double> colSums(regionCount, 0.0);
+  std::vector<int> counts(regionCount, 0);
+  for (std::size_t cell = 0; cell < regions.size(); cell++) {
+    if (regions[cell] >= 0) {
+      rowSums[regions[cell]] += static_cast<double>(cell / cols);
+      colSums[regions[cell]] += static_cast<double>(cell % cols);
+      counts[regions[cell]]++;
+    }
+  }
+
+  std::vector<int> centres(regionCount, -1);
+  std::vector<double> best(regionCount, 0.0);
+  for (std::size_t cell = 0; cell < regions.size(); cell++) {
+    const int region = regions[cell];
+    if (region < 0) {
+      continue;
+    }
+    const double rowOffset =
+        static_cast<double>(cell / cols) - rowSums[region] / counts[region];
+    const double colOffset =
+        static_cast<double>(cell % cols) - colSums[region] / counts[region];
+    const double distance = rowOffset * rowOffset + colOffset * colOffset;
+    if (centres[region] < 0 || distance < best[region]) {
+      centres[region] = static_cast<int>(cell);
+      best[region] = distance;
+    }
+  }
+  return centres;
+}
+
+} // namespace
+
+RegionPartition::RegionPartition(const GridMap &map, int regionCount,
+                                 const int rounds)
+    : m_colCount(map.getColCount()) {
+  // regionCount must be between 1 and the number of traversable Cells
+  if (regionCount < 1) {
+    std::cerr << "regionCount must be greater than 0. Updating value to 1.\n";
+    regionCount = 1;
+  } else if (regionCount > map.getTraversableCount()) {
+    std::cerr << "regionCount cannot exceed the number of traversable Cells. "
+                 "Updating value to "
+              << map.getTraversableCount() << ".\n";
+    regionCount = map.getTraversableCount();
+  }
+
+  // Spread the seeds out: each one is the Cell farthest from those before
+  // it, starting from the Cell farthest from the first traversable one
+  std::vector<int> seeds;
+  for (int cell = 0; seeds.empty() && cell < map.getRowCount() * m_colCount;
+       cell++) {
+    if (map.canOccupy(cell / m_colCount, cell % m_colCount)) {
+      seeds.push_back(cell);
+    }
+  }
+  if (seeds.empty()) {
+    return; // Nothing to split
+  }
+  std::vector<int> distances = cellDistances(map, seeds);
+  seeds.clear();
+  while (static_cast<int>(seeds.size()) < regionCount) {
+    const auto farthest = std::max_element(distances.begin(), distances.end());
+    if (*farthest <= 0 && !seeds.empty()) {
+      break; // Every reachable Cell is already a seed
+    }
+    seeds.push_back(static_cast<int>(farthest - distances.begin()));
+    distances = cellDistances(map, seeds);
+  }
+
+  // Regrow from the middle of each region, keeping the most even split
+  std::vector<int> regions;
+  std::vector<int> sizes;
+  growRegions(map, seeds, regions, sizes);
+  m_regions = regions;
+  m_sizes = sizes;
+  for (int round = 1; round < rounds; round++) {
+    const std::vector<int> centres =
+        regionCentres(regions, m_colCount, static_cast<int>(seeds.size()));
+    if (centres == seeds) {
+      break;
+    }
+    seeds = centres;
+    growRegions(map, seeds, regions, sizes);
+    if (*std::max_element(sizes.begin(), sizes.end()) <
+        *std::max_element(m_sizes.begin(), m_sizes.end())) {
+      m_regions = regions;
+      m_sizes = sizes;
+    }
+  }
+}
+
+RegionPartition::RegionPartition(const GridMap &map,
+                                 const std::vector<AircraftState> &seeds)
+    : m_colCount(map.getColCount()) {
+  std::vector<int> cells;
+  std::vector<bool> taken(static_cast<std::size_t>(map.getRowCount()) *
+                              m_colCount,
+                          false);
+  for (const AircraftState &seed : seeds) {
+    // Move the seed to the closest traversable Cell no other seed holds
+    int cell = -1;
+    if (map.isWithinBounds(seed.row, seed.col)) {
+      const std::vector<int> distances =
+          cellDistances(map, {seed.row * m_colCount + seed.col});
+      for (std::size_t other = 0; other < distances.size(); other++) {
+        if (distances[other] >= 0 && !taken[other] &&
+            map.canOccupy(static_cast<int>(other) / m_colCount,
+                          static_cast<int>(other) % m_colCount) &&
+            (cell < 0 || distances[other] < distances[cell])) {
+          cell = static_cast<int>(other);
+        }
+      }
+    }
+    if (cell < 0) {
+      std::cerr << "No free traversable Cell near the seed at [" << seed.row
+                << "][" << seed.col << "].\n";
+      throw std::exception();
+    }
+    taken[cell] = true;
+    cells.push_back(cell);
+  }
+  growRegions(map, cells, m_regions, m_sizes);
+}
+
+float RegionPartition::getImbalance() const {
+  if (m_sizes.empty()) {
+    return 1.0;
+  }
+  int total = 0;
+  for (const int size : m_sizes) {
+    total += size;
+  }
+  const float mean =
+      static_cast<float>(total) / static_cast<float>(m_sizes.size());
+  return static_cast<float>(*std::max_element(m_sizes.begin(), m_sizes.end())) /
+         mean;
+}
+
+void RegionPartition::restrictTo(GridMap &map, const int region) const {
+  for (std::size_t cell = 0; cell < m_regions.size(); cell++) {
+    const int row = static_cast<int>(cell) / m_colCount;
+    const int col = static_cast<int>(cell) % m_colCount;
+    if (m_regions[cell] != region && map.canOccupy(row, col) &&
+        !map.isScanned(row, col)) {
+      map.markScanned(row, col);
+    }
+  }
+}
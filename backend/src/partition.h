@@ -0,0 +1,98 @@
+#ifndef PARTITION
+#define PARTITION
+
+#include "map.h"
+#include "state.h"
+#include <vector>
+
+/*
+ * @brief Splits the traversable Cells of a map into connected regions of
+ * roughly equal size, for sharing a map between aircraft or threads.
+ *
+ * Regions are grown from one seed each by a breadth-first search that always
+ * extends the smallest region next, which keeps the sizes level and the
+ * shapes compact. Without given seeds, the seeds are spread out by farthest
+ * point sampling and then moved to the middle of their regions for a few
+ * rounds of regrowth, keeping the most even split.
+ */
+class RegionPartition {
+public:
+  /*
+   * @brief Constructs a RegionPartition with seeds of its own choosing.
+   *
+   * @param map The GridMap being split.
+   * @param regionCount The number of regions. Bounds checking ensures
+   * 1 <= regionCount <= the number of traversable Cells.
+   * @param rounds The most rounds of reseeding and regrowth.
+   *
+   * @return Nothing.
+   */
+  RegionPartition(const GridMap &map, int regionCount, int rounds = 8);
+  /*
+   * @brief Constructs a RegionPartition grown from fixed seeds, such as the
+   * start poses of a fleet. A seed on an untraversable Cell, or on the Cell
+   * of an earlier seed, is moved to the closest free Cell.
+   *
+   * @param map The GridMap being split.
+   * @param seeds The pose each region grows from.
+   *
+   * @return Nothing.
+   */
+  RegionPartition(const GridMap &map, const std::vector<AircraftState> &seeds);
+
+  /*
+   * @brief Getter for the region of a Cell.
+   *
+   * @param row The row of the Cell.
+   * @param col The column of the Cell.
+   *
+   * @return The region, or -1 for untraversable and unreachable Cells.
+   */
+  int getRegion(int row, int col) const {
+    return m_regions[row * m_colCount + col];
+  }
+  /*
+   * @brief Getter for the region of every Cell.
+   *
+   * @return The regions, indexed by row * columns + column.
+   */
+  const std::vector<int> &getRegions() const { return m_regions; }
+  /*
+   * @brief Getter for the number of regions.
+   *
+   * @return The number of regions.
+   */
+  int getRegionCount() const { return static_cast<int>(m_sizes.size()); }
+  /*
+   * @brief Getter for the size of a region.
+   *
+   * @param region The region.
+   *
+   * @return The number of Cells in the region.
+   */
+  int getRegionSize(int region) const { return m_sizes[region]; }
+  /*
+   * @brief Getter for how uneven the split is.
+   *
+   * @return The size of the largest region over the mean size; 1 is even.
+   */
+  float getImbalance() const;
+
+  /*
+   * @brief Restricts a planner to one region by marking every traversable
+   * Cell outside it as scanned.
+   *
+   * @param map A copy of the partitioned map, to be planned on.
+   * @param region The region to keep.
+   *
+   * @return Nothing.
+   */
+  void restrictTo(GridMap &map, int region) const;
+
+private:
+  int m_colCount = 0;         // Columns of the partitioned map
+  std::vector<int> m_regions; // Region of each Cell, -1 for none
+  std::vector<int> m_sizes;   // Cells in each region
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "pathfinder.h"
+#include "landmarks.h"
+#include "map.h"
+#include "roadmap.h"
+#include "search.h"
+#include "state.h"
+#include <memory>
+#include <vector>
+
+PathFinder::PathFinder(const GridMap &map, const PathEngine engine)
+    : m_map(&map), m_engine(engine) {
+  switch (engine) {
+  case PathEngine::engine_LANDMARKS:
+    m_landmarks = std::unique_ptr<LandmarkTable>(new LandmarkTable(map));
+    break;
+  case PathEngine::engine_ROADMAP:
+    m_roadmap = std::unique_ptr<Roadmap>(new Roadmap(map));
+    break;
+  case PathEngine::engine_BFS:
+  case PathEngine::engine_JUMP:
+    break;
+  }
+}
+
+std::vector<Moves> PathFinder::findPath(const AircraftState &start,
+                                        const int targetRow,
+                                        const int targetCol) {
+  switch (m_engine) {
+  case PathEngine::engine_LANDMARKS:
+    return shortestPath(*m_map, start, targetRow, targetCol, m_workspace,
+                        *m_landmarks);
+  case PathEngine::engine_ROADMAP:
+    return m_roadmap->findPath(start, targetRow, targetCol, m_workspace);
+  case PathEngine::engine_JUMP:
+    return jumpPointPath(*m_map, start, targetRow, targetCol, m_workspace);
+  case PathEngine::engine_BFS:
+    break;
+  }
+  return shortestPath(*m_map, start, targetRow, targetCol, m_workspace);
+}
@@ -0,0 +1,79 @@
+#ifndef PATHFINDER
+#define PATHFINDER
+
+#include "cancel.h"
+#include "landmarks.h"
+#include "map.h"
+#include "roadmap.h"
+#include "state.h"
+#include "workspace.h"
+#include <memory>
+#include <vector>
+
+// The algorithms a PathFinder can answer queries with
+enum class PathEngine {
+  engine_BFS,       // Exact breadth-first search over poses
+  engine_LANDMARKS, // Exact A* guided by landmark (ALT) distances
+  engine_ROADMAP,   // Near-optimal hierarchical search (HPA*)
+  engine_JUMP       // Exact jump point search over straight runs
+};
+
+/*
+ * @brief Answers repeated point-to-point path queries on one map with a
+ * chosen PathEngine. The engine's preprocessing and the search buffers are
+ * built once and reused by every query.
+ */
+class PathFinder {
+public:
+  /*
+   * @brief Constructs a PathFinder and runs the engine's preprocessing.
+   *
+   * @param map The GridMap queries run on. Must outlive the PathFinder.
+   * @param engine The algorithm used for queries.
+   *
+   * @return Nothing.
+   */
+  explicit PathFinder(const GridMap &map,
+                      PathEngine engine = PathEngine::engine_BFS);
+
+  /*
+   * @brief Finds a path from a pose to a Cell.
+   *
+   * @param start The pose the path starts from. Must be on the map.
+   * @param targetRow The row to reach.
+   * @param targetCol The column to reach.
+   *
+   * @return The moves, in order. Empty if the aircraft is already on the
+   * target Cell, the target cannot be reached or the CancelToken stopped the
+   * search.
+   */
+  std::vector<Moves> findPath(const AircraftState &start, int targetRow,
+                              int targetCol);
+
+  /*
+   * @brief Bounds every later query with a CancelToken, such as a deadline.
+   *
+   * @param token The token the searches poll.
+   *
+   * @return Nothing.
+   */
+  void setCancelToken(const CancelToken &token) {
+    m_workspace.setCancelToken(token);
+  }
+
+  /*
+   * @brief Getter for the engine answering queries.
+   *
+   * @return The PathEngine.
+   */
+  PathEngine getEngine() const { return m_engine; }
+
+private:
+  const GridMap *m_map; // The map queries run on
+  PathEngine m_engine;  // The algorithm used for queries
+  SearchWorkspace m_workspace;
+  std::unique_ptr<LandmarkTable> m_landmarks; // Built for engine_LANDMARKS
+  std::unique_ptr<Roadmap> m_roadmap;         // Built for engine_ROADMAP
+};
+
+#endif
@@ -0,0 +1,244 @@
+#include "planner.h"
+#include "aircraft.h"
+#include "beamsearch.h"
+#include "boustrophedon.h"
+#include "cancel.h"
+#include "map.h"
+#include "orienteering.h"
+#include "replay.h"
+#include "router1.h"
+#include "spanningtree.h"
+#include "state.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper class for the registry. Adapts a planner class constructed
+ * from (Aircraft, searchPercentage, moveLimit) with a findRoute(CancelToken)
+ * method.
+ */
+template <typename Planner> class PlannerAdapter : public CoveragePlanner {
+protected:
+  std::vector<Moves> route(const Aircraft &aircraft,
+                           const float searchPercentage,
+                           const int moveLimit,
+                           const CancelToken &token) override {
+    Planner planner(aircraft, searchPercentage, moveLimit);
+    return planner.findRoute(token);
+  }
+};
+
+/*
+ * @brief Helper class for the registry. RoutePlanner trying right turns
+ * before left ones.
+ */
+class RightFirstPlanner : public CoveragePlanner {
+protected:
+  std::vector<Moves> route(const Aircraft &aircraft,
+                           const float searchPercentage,
+                           const int moveLimit,
+                           const CancelToken &token) override {
+    RoutePlanner planner(aircraft, searchPercentage, moveLimit,
+                         TurnPreference::turn_RIGHTFIRST);
+    return planner.findRoute(token);
+  }
+};
+
+/*
+ * @brief Helper class for the registry. RoutePlanner repositioning along a
+ * tour of the unscanned clusters.
+ */
+class TourPlanner : public CoveragePlanner {
+protected:
+  std::vector<Moves> route(const Aircraft &aircraft,
+                           const float searchPercentage,
+                           const int moveLimit,
+                           const CancelToken &token) override {
+    RoutePlanner planner(aircraft, searchPercentage, moveLimit,
+                         TurnPreference::turn_LEFTFIRST,
+                         RepositionMode::reposition_TOUR);
+    return planner.findRoute(token);
+  }
+};
+
+/*
+ * @brief Helper function for the registry. Makes a factory for a planner
+ * class.
+ *
+ * @return The factory.
+ */
+template <typename Planner> PlannerFactory adapterFactory() {
+  return [] {
+    return std::unique_ptr<CoveragePlanner>(new PlannerAdapter<Planner>());
+  };
+}
+
+/*
+ * @brief Helper function for the registry. Makes a factory for a
+ * CoveragePlanner subclass.
+ *
+ * @return The factory.
+ */
+template <typename Planner> PlannerFactory plannerFactory() {
+  return [] { return std::unique_ptr<CoveragePlanner>(new Planner()); };
+}
+
+// A registered planner
+struct PlannerEntry {
+  std::string description; // One line about the planner
+  PlannerFactory factory;  // Makes the planner
+};
+
+/*
+ * @brief Helper function for the registry. The registered planners, with the
+ * built-in ones added on first use.
+ *
+ * @return The planners by name.
+ */
+std::map<std::string, PlannerEntry> &registry() {
+  static std::map<std::string, PlannerEntry> planners = {
+      {"greedy",
+       {"Greedy one-move lookahead, repositioning to the nearest new scan "
+        "(RoutePlanner)",
+        adapterFactory<RoutePlanner>()}},
+      {"greedy_right",
+       {"The greedy planner trying right turns before left ones",
+        plannerFactory<RightFirstPlanner>()}},
+      {"greedy_tour",
+       {"The greedy planner repositioning along a TSP tour of unscanned "
+        "clusters",
+        plannerFactory<TourPlanner>()}},
+      {"beam",
+       {"Beam search several steps ahead, ranked by Cells gained per move",
+        adapterFactory<BeamPlanner>()}},
+      {"orienteering",
+       {"Legs with the most new Cells per move, for tight move budgets",
+        adapterFactory<OrienteeringPlanner>()}},
+      {"boustrophedon",
+       {"Lane sweeps over a boustrophedon cell decomposition",
+        adapterFactory<BoustrophedonPlanner>()}},
+      {"spanning_tree",
+       {"Circuits around spanning trees of the sensor-sized block grid",
+        adapterFactory<SpanningTreePlanner>()}}};
+  return planners;
+}
+
+/*
+ * @brief Helper function for the registry. Looks up a planner by name.
+ *
+ * @param name The name of the planner.
+ *
+ * @return The planner's entry.
+ */
+const PlannerEntry &findEntry(const std::string &name) {
+  const auto found = registry().find(name);
+  if (found == registry().end()) {
+    std::cerr << "No planner is registered as \"" << name << "\".\n";
+    throw std::exception();
+  }
+  return found->second;
+}
+
+} // namespace
+
+PlanResult CoveragePlanner::plan(const GridMap &map,
+                                 const AircraftState &start,
+                                 const float searchPercentage,
+                                 const int moveLimit,
+                                 const CancelToken &token) {
+  const Aircraft aircraft(start.row, start.dir, start.col, map);
+  const float target = clampSearchPercentage(searchPercentage);
+  const auto began = std::chrono::steady_clock::now();
+  std::vector<Moves> moves =
+      route(aircraft, target, clampMoveLimit(moveLimit), token);
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - began)
+                             .count();
+
+  PlanResult result =
+      evaluateRoute(map, aircraft.getState(), std::move(moves), target);
+  result.planSeconds = seconds;
+  result.interrupted = !result.targetMet && token.stopRequested();
+  return result;
+}
+
+PlanResult evaluateRoute(const GridMap &map, const AircraftState &start,
+                         std::vector<Moves> moves,
+                         const float searchPercentage) {
+  PlanResult result;
+  result.start = start;
+  result.moves = std::move(moves);
+
+  const ReplayResult replay = replayRoute(map, start, result.moves);
+  const float target = clampSearchPercentage(searchPercentage);
+  result.valid = replay.valid;
+  result.scannedCount = replay.scannedCount;
+  result.coverage = replay.coverage;
+  result.targetMet =
+      replay.scannedCount >=
+      std::ceil(target * static_cast<float>(map.getTraversableCount()));
+  return result;
+}
+
+float clampSearchPercentage(const float searchPercentage) {
+  // searchPercentage is a float that must be between 0.01 (1%) and 1.0 (100%)
+  if (searchPercentage < PERCENT1) {
+    std::cerr << "searchPercentage must be at least 0.01 (1%). Updating value "
+                 "to 1%\n";
+    return PERCENT1;
+  }
+  if (searchPercentage > PERCENT100) {
+    std::cerr << "searchPercentage cannot be greater than 1.0 (100%). Updating "
+                 "value to 100%\n";
+    return PERCENT100;
+  }
+  return searchPercentage;
+}
+
+int clampMoveLimit(const int moveLimit) {
+  // moveLimit must be greater than zero
+  if (moveLimit < 1) {
+    std::cerr << "moveLimit must be greater than 0. Updating value to 1.\n";
+    return 1;
+  }
+  return moveLimit;
+}
+
+bool registerPlanner(const std::string &name, const std::string &description,
+                     PlannerFactory factory) {
+  registry()[name] = {description, std::move(factory)};
+  return true;
+}
+
+std::unique_ptr<CoveragePlanner> makePlanner(const std::string &name) {
+  return findEntry(name).factory();
+}
+
+std::vector<std::string> getPlannerNames() {
+  std::vector<std::string> names;
+  for (const auto &planner : registry()) {
+    names.push_back(planner.first);
+  }
+  return names;
+}
+
+std::string getPlannerDescription(const std::string &name) {
+  return findEntry(name).description;
+}
+
+PlanResult planRoute(const std::string &name, const GridMap &map,
+                     const AircraftState &start, const float searchPercentage,
+                     const int moveLimit, const CancelToken &token) {
+  return makePlanner(name)->plan(map, start, searchPercentage, moveLimit,
+                                 token);
+}
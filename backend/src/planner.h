@@ -0,0 +1,171 @@
+#ifndef PLANNER
+#define PLANNER
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * @brief A planned route and how well it does, checked by replaying it.
+ */
+struct PlanResult {
+  std::vector<Moves> moves; // The route, in order
+  AircraftState start{};    // Pose the route starts from
+  bool valid = false;       // True if every move is legal
+  bool targetMet = false;   // True if the coverage target was reached
+  int scannedCount = 0;     // Cells scanned, including the first scan
+  float coverage = 0.0;     // Fraction of traversable Cells scanned
+  double planSeconds = 0.0; // Wall-clock time spent planning
+  bool interrupted = false; // True if a CancelToken cut planning short
+};
+
+/*
+ * @brief The interface every coverage planner offers: a map, a start pose, a
+ * coverage target and a move budget in; a route and its statistics out.
+ */
+class CoveragePlanner {
+public:
+  virtual ~CoveragePlanner() = default;
+
+  /*
+   * @brief Plans a route, times it and replays it to fill in the statistics.
+   *
+   * @param map The GridMap to cover. It is not modified.
+   * @param start The pose to start from. An untraversable start is moved to
+   * the closest traversable Cell, as Aircraft does.
+   * @param searchPercentage The fraction of traversable Cells to scan,
+   * clamped to [0.01, 1].
+   * @param moveLimit The number of moves the route may use.
+   * @param token Stops planning early. The route flown so far is returned,
+   * with interrupted set if it falls short of the target.
+   *
+   * @return The route and its statistics.
+   */
+  PlanResult plan(const GridMap &map, const AircraftState &start,
+                  float searchPercentage, int moveLimit,
+                  const CancelToken &token = CancelToken());
+
+protected:
+  /*
+   * @brief Plans a route for an aircraft.
+   *
+   * @param aircraft The Aircraft being routed, at its start pose.
+   * @param searchPercentage The fraction of traversable Cells to scan.
+   * @param moveLimit The number of moves the route may use.
+   * @param token Polled while planning; once it asks to stop, the moves so
+   * far should be returned. They must be legal.
+   *
+   * @return The moves, in order.
+   */
+  virtual std::vector<Moves> route(const Aircraft &aircraft,
+                                   float searchPercentage, int moveLimit,
+                                   const CancelToken &token) = 0;
+};
+
+/*
+ * @brief Replays a route and fills in its statistics. The planning time is
+ * left at zero.
+ *
+ * @param map The GridMap the route covers. It is not modified.
+ * @param start The pose the route starts from.
+ * @param moves The route.
+ * @param searchPercentage The fraction of traversable Cells to scan,
+ * clamped to [0.01, 1].
+ *
+ * @return The route and its statistics.
+ */
+PlanResult evaluateRoute(const GridMap &map, const AircraftState &start,
+                         std::vector<Moves> moves, float searchPercentage);
+
+// The smallest and largest coverage targets a planner accepts
+constexpr float PERCENT1 = 0.01;
+constexpr float PERCENT100 = 1.0;
+
+/*
+ * @brief Bounds checks a coverage target the way every planner does, warning
+ * on std::cerr when the value is updated.
+ *
+ * @param searchPercentage The fraction of traversable Cells to scan.
+ *
+ * @return searchPercentage clamped to [0.01, 1].
+ */
+float clampSearchPercentage(float searchPercentage);
+
+/*
+ * @brief Bounds checks a move budget the way every planner does, warning on
+ * std::cerr when the value is updated.
+ *
+ * @param moveLimit The number of moves a route may use.
+ *
+ * @return moveLimit, or 1 if it is below 1.
+ */
+int clampMoveLimit(int moveLimit);
+
+// Makes a fresh planner for one request
+using PlannerFactory = std::function<std::unique_ptr<CoveragePlanner>()>;
+
+/*
+ * @brief Adds a planner to the registry, replacing any planner of the same
+ * name. The registry is not locked, so planners should be registered before
+ * requests are served.
+ *
+ * @param name The name the planner is selected by.
+ * @param description One line about the planner.
+ * @param factory Makes the planner.
+ *
+ * @return True, so that registration can initialise a static.
+ */
+bool registerPlanner(const std::string &name, const std::string &description,
+                     PlannerFactory factory);
+
+/*
+ * @brief Makes a registered planner. The built-in planners are "greedy"
+ * (RoutePlanner), "greedy_right" (RoutePlanner turning right first),
+ * "greedy_tour" (RoutePlanner repositioning along a CoverageTour), "beam"
+ * (BeamPlanner), "orienteering" (OrienteeringPlanner), "boustrophedon"
+ * (BoustrophedonPlanner) and "spanning_tree" (SpanningTreePlanner).
+ *
+ * @param name The name of the planner.
+ *
+ * @return The planner.
+ */
+std::unique_ptr<CoveragePlanner> makePlanner(const std::string &name);
+
+/*
+ * @brief Getter for the names of the registered planners.
+ *
+ * @return The names, in alphabetical order.
+ */
+std::vector<std::string> getPlannerNames();
+
+/*
+ * @brief Getter for the description of a registered planner.
+ *
+ * @param name The name of the planner.
+ *
+ * @return The description.
+ */
+std::string getPlannerDescription(const std::string &name);
+
+/*
+ * @brief Plans a route with a registered planner.
+ *
+ * @param name The name of the planner.
+ * @param map The GridMap to cover. It is not modified.
+ * @param start The pose to start from.
+ * @param searchPercentage The fraction of traversable Cells to scan.
+ * @param moveLimit The number of moves the route may use.
+ * @param token Stops planning early, keeping the route so far.
+ *
+ * @return The route and its statistics.
+ */
+PlanResult planRoute(const std::string &name, const GridMap &map,
+                     const AircraftState &start, float searchPercentage,
+                     int moveLimit, const CancelToken &token = CancelToken());
+
+#endif
@@ -0,0 +1,154 @@
+#include "portfolio.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "replay.h"
+#include "state.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for planPortfolio(). Plans the route of one entry.
+ *
+ * @param map The GridMap to cover.
+ * @param start The pose to start from.
+ * @param searchPercentage The fraction of traversable Cells to scan.
+ * @param moveLimit The number of moves the route may use.
+ * @param entry The configuration.
+ * @param token Stops planning early.
+ *
+ * @return The route and its statistics.
+ */
+PlanResult planEntry(const GridMap &map, const AircraftState &start,
+                     const float searchPercentage, const int moveLimit,
+                     const PortfolioEntry &entry, const CancelToken &token) {
+  const auto began = std::chrono::steady_clock::now();
+
+  // The aircraft's copy of the map is this entry's private scan state
+  Aircraft aircraft(start.row, start.dir, start.col, map);
+  const AircraftState origin = aircraft.getState();
+  std::vector<Moves> moves = turnsBetween(origin.dir, entry.heading);
+  if (static_cast<int>(moves.size()) > moveLimit) {
+    moves.resize(moveLimit);
+  }
+  aircraft.scan();
+  for (const Moves turn : moves) {
+    if (turn == Moves::move_TURNLEFT) {
+      aircraft.turnLeft();
+    } else {
+      aircraft.turnRight();
+    }
+    aircraft.scan();
+  }
+
+  const int remaining = moveLimit - static_cast<int>(moves.size());
+  if (remaining > 0) {
+    const PlanResult planned =
+        makePlanner(entry.planner)
+            ->plan(aircraft.getMap(), aircraft.getState(), searchPercentage,
+                   remaining, token);
+    moves.insert(moves.end(), planned.moves.begin(), planned.moves.end());
+  }
+  // A route may never win on moves its budget did not allow
+  if (static_cast<int>(moves.size()) > moveLimit) {
+    moves.resize(moveLimit);
+  }
+  // Stop at the move that meets the coverage target
+  const int targetScanCount = std::ceil(
+      searchPercentage * static_cast<float>(map.getTraversableCount()));
+  trimToScanCount(map, origin, moves, targetScanCount);
+
+  PlanResult result =
+      evaluateRoute(map, origin, std::move(moves), searchPercentage);
+  result.interrupted = !result.targetMet && token.stopRequested();
+  result.planSeconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - began)
+                           .count();
+  return result;
+}
+
+/*
+ * @brief Helper function for planPortfolio(). Ranks two routes.
+ *
+ * @param a One route.
+ * @param b The other route.
+ * @param goal What the routes are ranked by.
+ *
+ * @return True if a is strictly better than b, else false.
+ */
+bool better(const PlanResult &a, const PlanResult &b,
+            const PortfolioGoal goal) {
+  if (a.valid != b.valid) {
+    return a.valid;
+  }
+  if (goal == PortfolioGoal::goal_FEWESTMOVES && a.targetMet != b.targetMet) {
+    return a.targetMet;
+  }
+  if (goal == PortfolioGoal::goal_FEWESTMOVES && a.targetMet) {
+    if (a.moves.size() != b.moves.size()) {
+      return a.moves.size() < b.moves.size();
+    }
+    return a.scannedCount > b.scannedCount;
+  }
+  if (a.scannedCount != b.scannedCount) {
+    return a.scannedCount > b.scannedCount;
+  }
+  return a.moves.size() < b.moves.size();
+}
+
+} // namespace
+
+std::vector<PortfolioEntry> defaultPortfolio() {
+  std::vector<PortfolioEntry> entries;
+  for (const std::string &planner : getPlannerNames()) {
+    for (const Direction heading :
+         {Direction::dir_NORTH, Direction::dir_SOUTH, Direction::dir_EAST,
+          Direction::dir_WEST}) {
+      entries.push_back({planner, heading});
+    }
+  }
+  return entries;
+}
+
+PortfolioResult planPortfolio(const GridMap &map, const AircraftState &start,
+                              const float searchPercentage,
+                              const int moveLimit,
+                              const std::vector<PortfolioEntry> &entries,
+                              const PortfolioGoal goal,
+                              const int threadCount,
+                              const CancelToken &token) {
+  if (entries.empty()) {
+    std::cerr << "ERROR: planPortfolio() needs at least one entry."
+              << std::endl;
+    throw std::exception();
+  }
+
+  // Bounds check once, rather than in every entry's thread
+  const float target = clampSearchPercentage(searchPercentage);
+  const int limit = clampMoveLimit(moveLimit);
+  PortfolioResult portfolio;
+  portfolio.results.resize(entries.size());
+  ThreadPool pool(threadCount);
+  pool.parallelFor(static_cast<int>(entries.size()), [&](int index) {
+    portfolio.results[index] =
+        planEntry(map, start, target, limit, entries[index], token);
+  });
+
+  portfolio.bestIndex = 0;
+  for (int index = 1; index < static_cast<int>(entries.size()); index++) {
+    if (better(portfolio.results[index],
+               portfolio.results[portfolio.bestIndex], goal)) {
+      portfolio.bestIndex = index;
+    }
+  }
+  return portfolio;
+}
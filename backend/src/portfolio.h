@@ -0,0 +1,78 @@
+#ifndef PORTFOLIO
+#define PORTFOLIO
+
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "state.h"
+#include <string>
+#include <vector>
+
+// What a portfolio ranks its routes by
+enum class PortfolioGoal {
+  goal_FEWESTMOVES, // Meet the coverage target in the fewest moves
+  goal_MOSTCOVERAGE // Scan the most Cells within the move budget
+};
+
+/*
+ * @brief One configuration a portfolio tries: a registered planner, started
+ * after turning in place to a heading.
+ */
+struct PortfolioEntry {
+  std::string planner = "greedy";          // Name of a registered planner
+  Direction heading = Direction::dir_EAST; // Heading the planner starts from
+};
+
+/*
+ * @brief The routes a portfolio planned and which of them won.
+ */
+struct PortfolioResult {
+  std::vector<PlanResult> results; // One per entry, in entry order
+  int bestIndex = -1;              // Index of the winning route
+
+  /*
+   * @brief Getter for the winning route.
+   *
+   * @return The route at bestIndex.
+   */
+  const PlanResult &getBest() const { return results[bestIndex]; }
+};
+
+/*
+ * @brief Builds the portfolio of every registered planner started from each
+ * of the four headings.
+ *
+ * @return The entries.
+ */
+std::vector<PortfolioEntry> defaultPortfolio();
+
+/*
+ * @brief Plans one mission with several configurations at once and keeps the
+ * best route.
+ *
+ * Each entry runs on its own pool thread with its own copy of the map to
+ * scan, so the map passed in is only read. An entry whose heading differs
+ * from the start pose's begins with the turns to that heading, and every
+ * route is cut off as soon as it meets the coverage target, so all routes
+ * fly from the same start pose and compare fairly.
+ *
+ * @param map The GridMap to cover. It is not modified.
+ * @param start The pose to start from.
+ * @param searchPercentage The fraction of traversable Cells to scan.
+ * @param moveLimit The number of moves each route may use.
+ * @param entries The configurations to try. Must not be empty.
+ * @param goal What the routes are ranked by. Ties go to the earlier entry.
+ * @param threadCount The number of threads; values below 1 use every
+ * hardware thread.
+ * @param token Stops every entry early. Entries that have not started by
+ * then return the turns to their heading only.
+ *
+ * @return Every route and the index of the best one.
+ */
+PortfolioResult planPortfolio(
+    const GridMap &map, const AircraftState &start, float searchPercentage,
+    int moveLimit, const std::vector<PortfolioEntry> &entries,
+    PortfolioGoal goal = PortfolioGoal::goal_FEWESTMOVES, int threadCount = 0,
+    const CancelToken &token = CancelToken());
+
+#endif
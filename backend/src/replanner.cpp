@@ -0,0 +1,160 @@
+#include "replanner.h"
+#include "dstarlite.h"
+#include "map.h"
+#include "state.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for MissionReplanner. Finds the Cells an aircraft
+ * can reach. Turns happen in place, so every pose on a connected Cell can be
+ * reached too.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param row The aircraft's row.
+ * @param col The aircraft's column.
+ *
+ * @return Whether each Cell (row * columns + column) can be reached.
+ */
+std::vector<bool> reachableCells(const GridMap &map, const int row,
+                                 const int col) {
+  const int cols = map.getColCount();
+  std::vector<bool> reached(
+      static_cast<std::size_t>(map.getRowCount()) * cols, false);
+  std::vector<int> queue = {row * cols + col};
+  reached[queue.front()] = true;
+  for (std::size_t head = 0; head < queue.size(); head++) {
+    for (int dir = 0; dir < 4; dir++) {
+      const int nextRow = queue[head] / cols + motion::FORWARD_ROW[dir];
+      const int nextCol = queue[head] % cols + motion::FORWARD_COL[dir];
+      const int next = nextRow * cols + nextCol;
+      if (map.canOccupy(nextRow, nextCol) && !reached[next]) {
+        reached[next] = true;
+        queue.push_back(next);
+      }
+    }
+  }
+  return reached;
+}
+
+} // namespace
+
+MissionReplanner::MissionReplanner(const GridMap &map,
+                                   const AircraftState &start,
+                                   std::vector<Moves> route)
+    : m_map(map), m_state(start), m_remaining(std::move(route)) {}
+
+void MissionReplanner::advance(int moveCount) {
+  moveCount = std::min(std::max(moveCount, 0),
+                       static_cast<int>(m_remaining.size()));
+  for (int index = 0; index < moveCount; index++) {
+    m_state = applyMove(m_state, m_remaining[index]);
+  }
+  m_remaining.erase(m_remaining.begin(), m_remaining.begin() + moveCount);
+}
+
+bool MissionReplanner::markUntraversable(const int row, const int col) {
+  if (!m_map.canOccupy(row, col)) {
+    return false; // Off the map or already blocked
+  }
+  if (row == m_state.row && col == m_state.col) {
+    std::cerr << "The Cell at [" << row << "][" << col
+              << "] holds the aircraft and cannot be marked untraversable.\n";
+    throw std::exception();
+  }
+  m_map.markUntraversable(row, col);
+  if (m_paths) {
+    m_paths->cellBlocked(row, col);
+  }
+  return repairRoute();
+}
+
+std::vector<Moves> MissionReplanner::pathTo(const int row, const int col) {
+  if (!m_map.isWithinBounds(row, col)) {
+    return {};
+  }
+  return pathsTo(row, col).findPath(m_state);
+}
+
+long long MissionReplanner::getExpandedCount() const {
+  return m_retiredExpanded + (m_paths ? m_paths->getExpandedCount() : 0);
+}
+
+DStarLite &MissionReplanner::pathsTo(const int row, const int col) {
+  if (!m_paths || m_paths->getGoalRow() != row ||
+      m_paths->getGoalCol() != col) {
+    m_retiredExpanded += m_paths ? m_paths->getExpandedCount() : 0;
+    m_paths.reset(new DStarLite(m_map, row, col));
+  }
+  return *m_paths;
+}
+
+bool MissionReplanner::repairRoute() {
+  bool changed = false;
+  while (true) {
+    // poses[k] is the pose after the first k remaining moves
+    std::vector<AircraftState> poses = {m_state};
+    for (const Moves move : m_remaining) {
+      poses.push_back(applyMove(poses.back(), move));
+    }
+    int blocked = 1;
+    while (blocked < static_cast<int>(poses.size()) &&
+           m_map.canOccupy(poses[blocked].row, poses[blocked].col)) {
+      blocked++;
+    }
+    if (blocked == static_cast<int>(poses.size())) {
+      return changed;
+    }
+    changed = true;
+
+    // Rejoin the route at the first pose past the stretch that the aircraft
+    // can still reach from the pose before it
+    const AircraftState before = poses[blocked - 1];
+    std::vector<bool> reachable;
+    std::vector<Moves> detour;
+    int rejoin = -1;
+    for (int index = blocked + 1;
+         rejoin < 0 && index < static_cast<int>(poses.size()); index++) {
+      const AircraftState target = poses[index];
+      if (!m_map.canOccupy(target.row, target.col)) {
+        continue;
+      }
+      detour = pathsTo(target.row, target.col).findPath(before);
+      if (detour.empty() && (before.row != target.row ||
+                             before.col != target.col)) {
+        // Walled off; skip ahead to a Cell that can still be reached
+        if (reachable.empty()) {
+          reachable = reachableCells(m_map, before.row, before.col);
+        }
+        while (index + 1 < static_cast<int>(poses.size()) &&
+               !reachable[poses[index + 1].row * m_map.getColCount() +
+                          poses[index + 1].col]) {
+          index++;
+        }
+        continue;
+      }
+      AircraftState arrival = before;
+      for (const Moves move : detour) {
+        arrival = applyMove(arrival, move);
+      }
+      const std::vector<Moves> turns = turnsBetween(arrival.dir, target.dir);
+      detour.insert(detour.end(), turns.begin(), turns.end());
+      rejoin = index;
+    }
+
+    std::vector<Moves> repaired(m_remaining.begin(),
+                                m_remaining.begin() + (blocked - 1));
+    if (rejoin >= 0) {
+      repaired.insert(repaired.end(), detour.begin(), detour.end());
+      repaired.insert(repaired.end(), m_remaining.begin() + rejoin,
+                      m_remaining.end());
+    }
+    m_remaining = std::move(repaired);
+  }
+}
@@ -0,0 +1,123 @@
+#ifndef REPLANNER
+#define REPLANNER
+
+#include "dstarlite.h"
+#include "map.h"
+#include "state.h"
+#include <memory>
+#include <vector>
+
+/*
+ * @brief Keeps a mission's route flyable while obstacles appear under way.
+ *
+ * The replanner holds its own copy of the map, the aircraft's pose and the
+ * moves still to fly. When a Cell is marked untraversable, each stretch of
+ * the remaining route that runs into it is cut out and replaced by a shortest
+ * detour to the first pose past the stretch, so the rest of the route is
+ * kept as planned. Detours and repositioning legs come from a DStarLite kept
+ * for the latest goal Cell. Only queries to that same Cell reuse it, such as
+ * repeated pathTo() calls to one Cell while obstacles appear, or a detour
+ * that rejoins where the last one did; those are repaired incrementally. Any
+ * other goal starts a fresh search.
+ */
+class MissionReplanner {
+public:
+  /*
+   * @brief Constructs a MissionReplanner.
+   *
+   * @param map The GridMap the route was planned on. It is copied.
+   * @param start The aircraft's current pose.
+   * @param route The moves still to fly. Must be legal on the map.
+   *
+   * @return Nothing.
+   */
+  MissionReplanner(const GridMap &map, const AircraftState &start,
+                   std::vector<Moves> route);
+
+  // The DStarLite points into the map copy, so the copy may not move
+  MissionReplanner(const MissionReplanner &) = delete;
+  MissionReplanner &operator=(const MissionReplanner &) = delete;
+
+  /*
+   * @brief Records that the aircraft flew the next moves of the route.
+   *
+   * @param moveCount The number of moves flown. Clamped to the route left.
+   *
+   * @return Nothing.
+   */
+  void advance(int moveCount);
+  /*
+   * @brief Marks a Cell untraversable and repairs the remaining route around
+   * it. A stretch past which the route cannot be rejoined ends the route
+   * where the stretch starts.
+   *
+   * @param row The row of the Cell.
+   * @param col The column of the Cell. Must not be the aircraft's own Cell.
+   *
+   * @return True if the remaining route changed, else false.
+   */
+  bool markUntraversable(int row, int col);
+  /*
+   * @brief Finds a shortest repositioning path from the aircraft to a Cell
+   * on the edited map.
+   *
+   * @param row The row to reach.
+   * @param col The column to reach.
+   *
+   * @return The moves, in order. Empty if the aircraft is already on the
+   * Cell or the Cell cannot be reached.
+   */
+  std::vector<Moves> pathTo(int row, int col);
+
+  /*
+   * @brief Getter for the moves still to fly.
+   *
+   * @return The remaining route, in order.
+   */
+  const std::vector<Moves> &getRemainingRoute() const { return m_remaining; }
+  /*
+   * @brief Getter for the aircraft's pose.
+   *
+   * @return The pose after the moves flown so far.
+   */
+  AircraftState getState() const { return m_state; }
+  /*
+   * @brief Getter for the map, including every Cell marked untraversable.
+   *
+   * @return The GridMap.
+   */
+  const GridMap &getMap() const { return m_map; }
+  /*
+   * @brief Getter for the search work done so far.
+   *
+   * @return The number of poses every DStarLite has expanded.
+   */
+  long long getExpandedCount() const;
+
+private:
+  GridMap m_map;                      // The map, with obstacles as they appear
+  AircraftState m_state;              // The aircraft's pose
+  std::vector<Moves> m_remaining;     // Moves still to fly
+  std::unique_ptr<DStarLite> m_paths; // Paths to the latest goal Cell
+  long long m_retiredExpanded = 0;    // Work of DStarLites since replaced
+
+  /*
+   * @brief Getter for a DStarLite to a Cell, reusing the current one if it
+   * has the same goal.
+   *
+   * @param row The goal row.
+   * @param col The goal column.
+   *
+   * @return The DStarLite.
+   */
+  DStarLite &pathsTo(int row, int col);
+  /*
+   * @brief Replaces every stretch of the remaining route that enters an
+   * untraversable Cell with a detour.
+   *
+   * @return True if the remaining route changed, else false.
+   */
+  bool repairRoute();
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "replay.h"
+#include "bitgrid.h"
+#include "map.h"
+#include "state.h"
+#include "threadpool.h"
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for replayRoute(). Scans from a pose into the
+ * replay's overlay.
+ *
+ * @param map The GridMap being scanned.
+ * @param overlay The replay's scanned plane.
+ * @param state The pose scanning.
+ * @param newCells If not nullptr, receives the newly scanned Cells.
+ *
+ * @return The number of Cells newly scanned.
+ */
+int scanInto(const GridMap &map, BitGrid &overlay, const AircraftState &state,
+             std::vector<std::pair<int, int>> *newCells) {
+  const std::array<int, 4> area = scanFootprint(state);
+  return map.scanAreaInto(overlay, area[0], area[1], area[2], area[3],
+                          newCells);
+}
+
+} // namespace
+
+ReplayResult replayRoute(const GridMap &map, const AircraftState &start,
+                         const std::vector<Moves> &moves, bool recordCells) {
+  ReplayResult result;
+  BitGrid overlay = map.getScannedPlane();
+
+  result.stepGains.reserve(moves.size());
+  result.states.reserve(moves.size());
+  if (recordCells) {
+    result.scannedCells.reserve(moves.size());
+  }
+
+  AircraftState state = start;
+  if (!map.canOccupy(state.row, state.col)) {
+    // The route cannot start on an untraversable Cell
+    result.valid = false;
+    result.firstIllegalMove = 0;
+    result.finalState = state;
+    return result;
+  }
+
+  result.initialGain = scanInto(map, overlay, state, nullptr);
+  result.scannedCount = result.initialGain;
+
+  for (std::size_t i = 0; i < moves.size(); i++) {
+    if (!step(state, moves[i], map, state)) {
+      result.valid = false;
+      result.firstIllegalMove = static_cast<int>(i);
+      break;
+    }
+    std::vector<std::pair<int, int>> *cells = nullptr;
+    if (recordCells) {
+      result.scannedCells.emplace_back();
+      cells = &result.scannedCells.back();
+    }
+    const int gain = scanInto(map, overlay, state, cells);
+    result.stepGains.push_back(gain);
+    result.states.push_back(state);
+    result.scannedCount += gain;
+    result.movesFlown++;
+  }
+
+  result.finalState = state;
+  if (map.getTraversableCount() > 0) {
+    result.coverage = static_cast<float>(result.scannedCount) /
+                      static_cast<float>(map.getTraversableCount());
+  }
+  return result;
+}
+
+bool trimToScanCount(const GridMap &map, const AircraftState &start,
+                     std::vector<Moves> &moves, const int targetScanCount) {
+  const ReplayResult replay = replayRoute(map, start, moves);
+  int scannedCount = replay.initialGain;
+  for (int index = 0; index < replay.movesFlown; index++) {
+    if (scannedCount >= targetScanCount) {
+      moves.resize(index);
+      return true;
+    }
+    scannedCount += replay.stepGains[index];
+  }
+  return scannedCount >= targetScanCount;
+}
+
+std::vector<ReplayResult>
+replayRoutes(const GridMap &map, const std::vector<AircraftState> &starts,
+             const std::vector<std::vector<Moves>> &routes, int threadCount) {
+  if (starts.size() != routes.size()) {
+    std::cerr << "ERROR: replayRoutes() needs one start per route."
+              << std::endl;
+    throw std::exception();
+  }
+
+  std::vector<ReplayResult> results(routes.size());
+  ThreadPool pool(threadCount);
+  // Each replay owns its overlay, so the routes share the map read-only
+  pool.parallelFor(static_cast<int>(routes.size()), [&](int index) {
+    results[index] = replayRoute(map, starts[index], routes[index]);
+  });
+  return results;
+}
@@ -0,0 +1,75 @@
+#ifndef REPLAY
+#define REPLAY
+
+#include "map.h"
+#include "state.h"
+#include <utility>
+#include <vector>
+
+/*
+ * @brief The outcome of flying a route over a GridMap.
+ */
+struct ReplayResult {
+  bool valid = true;         // True if every move was legal
+  int firstIllegalMove = -1; // Index of the first illegal move, or -1
+  int movesFlown = 0;        // Number of legal moves replayed
+  int scannedCount = 0;      // Cells newly scanned, including the first scan
+  float coverage = 0.0;      // Fraction of traversable Cells scanned
+  int initialGain = 0;       // Cells scanned from the start pose
+  AircraftState finalState{}; // Pose after the last legal move
+  std::vector<int> stepGains; // Cells newly scanned after each legal move
+  std::vector<AircraftState> states; // Pose after each legal move
+  // Newly scanned <row, column> Cells after each legal move; only filled
+  // when requested
+  std::vector<std::vector<std::pair<int, int>>> scannedCells;
+};
+
+/*
+ * @brief Flies a route the way RoutePlanner does (scan at the start pose,
+ * then scan after every move) and reports its legality and coverage.
+ *
+ * @note The map is not modified: scans go to a private overlay seeded with the
+ * map's scanned Cells, so coverage counts only Cells the route adds.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param start The pose the route starts from.
+ * @param moves The route.
+ * @param recordCells If true, fill ReplayResult::scannedCells.
+ *
+ * @return The replay of the route, stopped at the first illegal move.
+ */
+ReplayResult replayRoute(const GridMap &map, const AircraftState &start,
+                         const std::vector<Moves> &moves,
+                         bool recordCells = false);
+
+/*
+ * @brief Cuts a route off at the move whose scan brings the Cells it has
+ * scanned up to a count.
+ *
+ * @param map The GridMap the route is flown over.
+ * @param start The pose the route starts from.
+ * @param moves The route. Shortened in place.
+ * @param targetScanCount The number of Cells to scan.
+ *
+ * @return True if the route, as cut, scans targetScanCount Cells, else false.
+ */
+bool trimToScanCount(const GridMap &map, const AircraftState &start,
+                     std::vector<Moves> &moves, int targetScanCount);
+
+/*
+ * @brief Replays many routes over the same map in parallel.
+ *
+ * @param map The GridMap every route is flown over.
+ * @param starts The start pose of each route.
+ * @param routes The routes, parallel to starts.
+ * @param threadCount Number of threads to use. Values below 1 select the
+ * number of hardware threads.
+ *
+ * @return One ReplayResult per route, in the same order.
+ */
+std::vector<ReplayResult>
+replayRoutes(const GridMap &map, const std::vector<AircraftState> &starts,
+             const std::vector<std::vector<Moves>> &routes,
+             int threadCount = 0);
+
+#endif
@@ -0,0 +1,269 @@
+#include "roadmap.h"
+#include "map.h"
+#include "search.h"
+#include "state.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Open borders at least this long get entrances at both ends as well as the
+// middle, so that paths hugging either side need not detour
+constexpr int LONG_BORDER = 6;
+
+/*
+ * @brief Helper function for the Roadmap constructor. Chooses where along an
+ * open stretch of border the entrances go.
+ *
+ * @param length The number of open Cells in the stretch.
+ *
+ * @return The offsets of the entrances from the start of the stretch.
+ */
+std::vector<int> entranceOffsets(const int length) {
+  if (length < LONG_BORDER) {
+    return {length / 2};
+  }
+  return {0, length / 2, length - 1};
+}
+
+/*
+ * @brief Helper function for the Roadmap constructor. Walks one side of a
+ * block border and reports every entrance position.
+ *
+ * @param length The number of Cells along the border.
+ * @param isOpen Tells whether both Cells at an offset along the border are
+ * traversable.
+ * @param addEntrance Called with the offset of every entrance.
+ *
+ * @return Nothing.
+ */
+void forEachEntrance(const int length, const std::function<bool(int)> &isOpen,
+                     const std::function<void(int)> &addEntrance) {
+  int runStart = -1;
+  for (int offset = 0; offset <= length; offset++) {
+    const bool open = offset < length && isOpen(offset);
+    if (open && runStart < 0) {
+      runStart = offset;
+    } else if (!open && runStart >= 0) {
+      for (const int entrance : entranceOffsets(offset - runStart)) {
+        addEntrance(runStart + entrance);
+      }
+      runStart = -1;
+    }
+  }
+}
+
+} // namespace
+
+Roadmap::Roadmap(const GridMap &map, const int blockSize)
+    : m_map(&map), m_blockSize(std::max(blockSize, 2)) {
+  const int rows = map.getRowCount();
+  const int cols = map.getColCount();
+  m_blockRows = (rows + m_blockSize - 1) / m_blockSize;
+  m_blockCols = (cols + m_blockSize - 1) / m_blockSize;
+  m_nodeOfState.assign(stateCount(map), -1);
+  m_blockNodes.resize(m_blockRows * m_blockCols);
+
+  // Borders between columns of blocks, one block row at a time
+  for (int border = m_blockSize; border < cols; border += m_blockSize) {
+    for (int first = 0; first < rows; first += m_blockSize) {
+      forEachEntrance(
+          std::min(m_blockSize, rows - first),
+          [&](const int offset) {
+            return map.canOccupy(first + offset, border - 1) &&
+                   map.canOccupy(first + offset, border);
+          },
+          [&](const int offset) {
+            addCrossing(
+                makeState(first + offset, border - 1, Direction::dir_EAST));
+            addCrossing(makeState(first + offset, border, Direction::dir_WEST));
+          });
+    }
+  }
+
+  // Borders between rows of blocks, one block column at a time
+  for (int border = m_blockSize; border < rows; border += m_blockSize) {
+    for (int first = 0; first < cols; first += m_blockSize) {
+      forEachEntrance(
+          std::min(m_blockSize, cols - first),
+          [&](const int offset) {
+            return map.canOccupy(border - 1, first + offset) &&
+                   map.canOccupy(border, first + offset);
+          },
+          [&](const int offset) {
+            addCrossing(
+                makeState(border - 1, first + offset, Direction::dir_SOUTH));
+            addCrossing(
+                makeState(border, first + offset, Direction::dir_NORTH));
+          });
+    }
+  }
+
+  // Distances between the entrances of each block
+  SearchWorkspace workspace;
+  for (int block = 0; block < m_blockRows * m_blockCols; block++) {
+    connectBlock(block, workspace);
+  }
+}
+
+std::array<int, 4> Roadmap::blockArea(const int block) const {
+  const int firstRow = (block / m_blockCols) * m_blockSize;
+  const int firstCol = (block % m_blockCols) * m_blockSize;
+  return {{firstRow, firstCol,
+           std::min(firstRow + m_blockSize, m_map->getRowCount()) - 1,
+           std::min(firstCol + m_blockSize, m_map->getColCount()) - 1}};
+}
+
+void Roadmap::addCrossing(const AircraftState &from) {
+  const int fromNode = addNode(from);
+  const int toNode = addNode(applyMove(from, Moves::move_FORWARD));
+  m_edges[fromNode].emplace_back(toNode, 1);
+}
+
+int Roadmap::addNode(const AircraftState &state) {
+  const int id = stateId(*m_map, state);
+  if (m_nodeOfState[id] < 0) {
+    m_nodeOfState[id] = static_cast<int>(m_nodes.size());
+    m_nodes.push_back(state);
+    m_edges.emplace_back();
+    m_blockNodes[blockOf(state.row, state.col)].push_back(m_nodeOfState[id]);
+  }
+  return m_nodeOfState[id];
+}
+
+void Roadmap::connectBlock(const int block, SearchWorkspace &workspace) {
+  const std::array<int, 4> area = blockArea(block);
+  for (const int from : m_blockNodes[block]) {
+    searchWithin(*m_map, m_nodes[from], area, workspace);
+    for (const int to : m_blockNodes[block]) {
+      const int toId = stateId(*m_map, m_nodes[to]);
+      if (to != from && workspace.isVisited(toId)) {
+        m_edges[from].emplace_back(to, workspace.getCost(toId));
+      }
+    }
+  }
+}
+
+std::vector<Moves> Roadmap::findPath(const AircraftState &start,
+                                     const int targetRow, const int targetCol,
+                                     SearchWorkspace &workspace) const {
+  if ((start.row == targetRow && start.col == targetCol) ||
+      !m_map->canOccupy(targetRow, targetCol)) {
+    return {};
+  }
+  const int startBlock = blockOf(start.row, start.col);
+  const int goalBlock = blockOf(targetRow, targetCol);
+
+  // One backward search gives the distance from every pose of the goal block
+  // to the target, including the start when it shares the block
+  const std::array<int, 4> goalArea = blockArea(goalBlock);
+  searchToCellWithin(*m_map, targetRow, targetCol, goalArea, workspace);
+  const int startId = stateId(*m_map, start);
+  const int direct = startBlock == goalBlock && workspace.isVisited(startId)
+                         ? workspace.getCost(startId)
+                         : -1;
+  std::vector<int> goalLeg(m_nodes.size(), -1);
+  for (const int node : m_blockNodes[goalBlock]) {
+    const int id = stateId(*m_map, m_nodes[node]);
+    if (workspace.isVisited(id)) {
+      goalLeg[node] = workspace.getCost(id);
+    }
+  }
+
+  // Dijkstra over the entrances, seeded with the distances from the start to
+  // the entrances of its block. Node m_nodes.size() stands for the target.
+  const int goal = static_cast<int>(m_nodes.size());
+  const int infinity = std::numeric_limits<int>::max();
+  std::vector<int> distance(m_nodes.size() + 1, infinity);
+  std::vector<int> previous(m_nodes.size() + 1, -1);
+  using Entry = std::pair<int, int>; // <distance, node>
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+  searchWithin(*m_map, start, blockArea(startBlock), workspace);
+  if (workspace.stopRequested()) {
+    return {};
+  }
+  for (const int node : m_blockNodes[startBlock]) {
+    const int id = stateId(*m_map, m_nodes[node]);
+    if (workspace.isVisited(id)) {
+      distance[node] = workspace.getCost(id);
+      open.emplace(distance[node], node);
+    }
+  }
+
+  while (!open.empty()) {
+    const Entry entry = open.top();
+    open.pop();
+    const int node = entry.second;
+    if (entry.first != distance[node]) {
+      continue; // Stale entry
+    }
+    if (node == goal) {
+      break;
+    }
+    const auto relax = [&](const int next, const int cost) {
+      if (distance[node] + cost < distance[next]) {
+        distance[next] = distance[node] + cost;
+        previous[next] = node;
+        open.emplace(distance[next], next);
+      }
+    };
+    for (const std::pair<int, int> &edge : m_edges[node]) {
+      relax(edge.first, edge.second);
+    }
+    if (goalLeg[node] >= 0) {
+      relax(goal, goalLeg[node]);
+    }
+  }
+
+  if (distance[goal] == infinity && direct < 0) {
+    // The entrances do not connect the endpoints, so search exactly
+    return shortestPath(*m_map, start, targetRow, targetCol, workspace);
+  }
+  if (direct >= 0 && direct <= distance[goal]) {
+    searchToCellWithin(*m_map, targetRow, targetCol, goalArea, workspace);
+    return pathToSearchedCell(*m_map, start, workspace);
+  }
+
+  // Refine the abstract route into moves
+  std::vector<int> chain;
+  for (int node = previous[goal]; node >= 0; node = previous[node]) {
+    chain.push_back(node);
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  std::vector<Moves> path;
+  AircraftState current = start;
+  for (const int node : chain) {
+    const AircraftState &next = m_nodes[node];
+    if (blockOf(current.row, current.col) != blockOf(next.row, next.col)) {
+      path.push_back(Moves::move_FORWARD); // Crossing a border
+    } else if (current != next) {
+      searchWithin(*m_map, current, blockArea(blockOf(next.row, next.col)),
+                   workspace);
+      const std::vector<Moves> leg =
+          pathFromSearch(*m_map, current, next, workspace);
+      if (leg.empty()) {
+        return {}; // The CancelToken stopped the search
+      }
+      path.insert(path.end(), leg.begin(), leg.end());
+    }
+    current = next;
+  }
+  searchToCellWithin(*m_map, targetRow, targetCol, goalArea, workspace);
+  const std::vector<Moves> lastLeg =
+      pathToSearchedCell(*m_map, current, workspace);
+  if (lastLeg.empty() &&
+      (current.row != targetRow || current.col != targetCol)) {
+    return {};
+  }
+  path.insert(path.end(), lastLeg.begin(), lastLeg.end());
+  return path;
+}
@@ -0,0 +1,122 @@
+#ifndef ROADMAP
+#define ROADMAP
+
+#include "map.h"
+#include "state.h"
+#include "workspace.h"
+#include <array>
+#include <utility>
+#include <vector>
+
+/*
+ * @brief A two-level roadmap of a GridMap for long-distance path queries
+ * (HPA*: hierarchical path-finding A*).
+ *
+ * The map is cut into square blocks. Where two blocks share an open border,
+ * entrance poses are placed on both sides: the pose facing across the border
+ * and the pose it lands on after one forward move. Inside each block the
+ * distance between every pair of entrance poses is measured once with the
+ * aircraft's own motion model. A query then searches this small abstract
+ * graph and refines only the blocks on the chosen route, so its cost barely
+ * depends on how far apart the endpoints are.
+ *
+ * Paths are near-optimal rather than optimal: they cross borders only at
+ * entrances. The roadmap is a snapshot of the terrain; rebuild it after Cells
+ * are marked untraversable.
+ */
+class Roadmap {
+public:
+  /*
+   * @brief Builds the roadmap.
+   *
+   * @param map The GridMap the roadmap covers. Must outlive the roadmap.
+   * @param blockSize The side length of a block, in Cells.
+   *
+   * @return Nothing.
+   */
+  explicit Roadmap(const GridMap &map, int blockSize = 16);
+
+  /*
+   * @brief Finds a path from a pose to a Cell through the roadmap.
+   *
+   * Falls back to an exact search when the abstract graph does not connect
+   * the endpoints.
+   *
+   * @param start The pose the path starts from. Must be on the map.
+   * @param targetRow The row to reach.
+   * @param targetCol The column to reach.
+   * @param workspace The buffers the searches run in.
+   *
+   * @return The moves, in order. Empty if the aircraft is already on the
+   * target Cell, the target cannot be reached or the workspace's CancelToken
+   * stopped the search.
+   */
+  std::vector<Moves> findPath(const AircraftState &start, int targetRow,
+                              int targetCol, SearchWorkspace &workspace) const;
+
+  /*
+   * @brief Getter for the number of entrance poses in the abstract graph.
+   *
+   * @return The number of abstract nodes.
+   */
+  int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+
+private:
+  /*
+   * @brief The block a Cell belongs to.
+   *
+   * @param row The row of the Cell.
+   * @param col The column of the Cell.
+   *
+   * @return The block index.
+   */
+  int blockOf(int row, int col) const {
+    return (row / m_blockSize) * m_blockCols + col / m_blockSize;
+  }
+  /*
+   * @brief The Cells of a block.
+   *
+   * @param block The block index.
+   *
+   * @return The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+   */
+  std::array<int, 4> blockArea(int block) const;
+  /*
+   * @brief Adds an entrance pair across a border: the pose facing across it
+   * and the pose one forward move later, joined by an edge of cost 1.
+   *
+   * @param from The pose facing across the border.
+   *
+   * @return Nothing.
+   */
+  void addCrossing(const AircraftState &from);
+  /*
+   * @brief Adds an abstract node for a pose if it does not have one yet.
+   *
+   * @param state The pose.
+   *
+   * @return The node index.
+   */
+  int addNode(const AircraftState &state);
+  /*
+   * @brief Measures the distances between the entrance poses of one block.
+   *
+   * @param block The block index.
+   * @param workspace The buffers the searches run in.
+   *
+   * @return Nothing.
+   */
+  void connectBlock(int block, SearchWorkspace &workspace);
+
+  const GridMap *m_map;  // The map the roadmap covers
+  int m_blockSize = 0;   // Side length of a block, in Cells
+  int m_blockRows = 0;   // Number of rows of blocks
+  int m_blockCols = 0;   // Number of columns of blocks
+  std::vector<AircraftState> m_nodes;            // Entrance poses
+  std::vector<int> m_nodeOfState;                // Node of a pose id, or -1
+  std::vector<std::vector<int>> m_blockNodes;    // Nodes inside each block
+  // Abstract edges of each node as <node, cost>
+  std::vector<std::vector<std::pair<int, int>>> m_edges;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "routebuilder.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "search.h"
+#include "state.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+RouteBuilder::RouteBuilder(const Aircraft &aircraft,
+                           const float searchPercentage, const int moveLimit,
+                           const CancelToken &token)
+    : m_aircraft(aircraft), m_token(token), m_moveLimit(moveLimit) {
+  m_workspace.setCancelToken(token);
+  m_targetScanCount =
+      std::ceil(searchPercentage *
+                static_cast<float>(m_aircraft.getMap().getTraversableCount()));
+  m_aircraft.trackScanGains();
+  m_scannedCount = m_aircraft.scan();
+}
+
+void RouteBuilder::fly(const std::vector<Moves> &moves) {
+  for (const Moves move : moves) {
+    if (!routing()) {
+      return;
+    }
+    switch (move) {
+    case Moves::move_FORWARD:
+      m_aircraft.moveForward();
+      break;
+    case Moves::move_TURNLEFT:
+      m_aircraft.turnLeft();
+      break;
+    case Moves::move_TURNRIGHT:
+      m_aircraft.turnRight();
+      break;
+    }
+    m_moveList.push_back(move);
+    m_scannedCount += m_aircraft.scan();
+  }
+}
+
+bool RouteBuilder::flyTo(const int row, const int col, const Direction dir) {
+  const AircraftState state = m_aircraft.getState();
+  if (state.row != row || state.col != col) {
+    const std::vector<Moves> path =
+        jumpPointPath(m_aircraft.getMap(), state, row, col, m_workspace);
+    if (path.empty()) {
+      return false;
+    }
+    fly(path);
+  }
+  fly(turnsBetween(m_aircraft.getDir(), dir));
+  return m_aircraft.getState() == makeState(row, col, dir);
+}
+
+void RouteBuilder::flyStraight(int steps) {
+  steps = std::min(steps, m_moveLimit - static_cast<int>(m_moveList.size()));
+  if (steps <= 0 || !routing()) {
+    return;
+  }
+  // A run that would reach the target is flown move by move so that the
+  // route stops exactly there; any other run is scanned in one pass
+  const std::array<int, 4> area = sweptFootprint(m_aircraft.getState(), steps);
+  const int gain =
+      m_aircraft.getMap().scanAreaGain(area[0], area[1], area[2], area[3]);
+  if (m_scannedCount + gain >= m_targetScanCount) {
+    fly(std::vector<Moves>(steps, Moves::move_FORWARD));
+    return;
+  }
+  m_scannedCount += m_aircraft.forward(steps);
+  m_moveList.insert(m_moveList.end(), steps, Moves::move_FORWARD);
+}
+
+void RouteBuilder::pickUpMissed() {
+  while (routing()) {
+    const std::vector<Moves> path =
+        pathToNewScan(m_aircraft.getMap(), m_aircraft.getState(), m_workspace);
+    if (path.empty()) {
+      return;
+    }
+    fly(path);
+    while (routing() && m_aircraft.forwardRunLength(1) == 1 &&
+           footprintGain(m_aircraft.getMap(),
+                         advancedBy(m_aircraft.getState(), 1)) > 0) {
+      fly({Moves::move_FORWARD});
+    }
+  }
+}
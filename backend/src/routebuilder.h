@@ -0,0 +1,120 @@
+#ifndef ROUTEBUILDER
+#define ROUTEBUILDER
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include "workspace.h"
+#include <vector>
+
+/*
+ * @brief Flies a copy of an Aircraft on behalf of a coverage planner and
+ * records the route, scanning after every move the way RoutePlanner does.
+ *
+ * Planners that lay out their own route (lanes, tree circuits) describe it
+ * as straight runs and legs to poses; the builder keeps the coverage and
+ * move counts and stops adding moves as soon as the coverage target is met,
+ * the move limit is reached or its CancelToken asks it to stop.
+ */
+class RouteBuilder {
+public:
+  /*
+   * @brief Constructs a RouteBuilder and makes the scan at the start pose.
+   *
+   * @param aircraft The Aircraft being routed. It is copied, not modified.
+   * @param searchPercentage The fraction of traversable Cells to scan.
+   * @param moveLimit The number of moves the route may use.
+   * @param token Stops the route early, keeping the moves so far.
+   *
+   * @return Nothing.
+   */
+  RouteBuilder(const Aircraft &aircraft, float searchPercentage,
+               int moveLimit, const CancelToken &token = CancelToken());
+
+  /*
+   * @brief Determines if the route should go on.
+   *
+   * @return True if coverage and move budget both remain and the
+   * CancelToken has not asked to stop, else false.
+   */
+  bool routing() const {
+    return m_scannedCount < m_targetScanCount &&
+           static_cast<int>(m_moveList.size()) < m_moveLimit &&
+           !m_token.stopRequested();
+  }
+
+  /*
+   * @brief Flies moves one at a time, scanning after each. Stops early once
+   * routing() turns false.
+   *
+   * @param moves The moves to fly. Must be legal.
+   *
+   * @return Nothing.
+   */
+  void fly(const std::vector<Moves> &moves);
+  /*
+   * @brief Flies to a Cell along a shortest path and turns to face a
+   * Direction.
+   *
+   * @param row The row to reach.
+   * @param col The column to reach.
+   * @param dir The Direction to face on arrival.
+   *
+   * @return True if the pose was reached, else false.
+   */
+  bool flyTo(int row, int col, Direction dir);
+  /*
+   * @brief Flies straight ahead, scanning the whole run in one pass unless
+   * the run reaches the coverage target.
+   *
+   * @param steps The length of the run. Must be legal.
+   *
+   * @return Nothing.
+   */
+  void flyStraight(int steps);
+  /*
+   * @brief Picks up Cells the planner's own pattern missed: flies to the
+   * closest pose that scans something new, then keeps going straight while
+   * that pays off, until routing() turns false or nothing is left.
+   *
+   * @return Nothing.
+   */
+  void pickUpMissed();
+
+  /*
+   * @brief Getter for the Aircraft's current pose.
+   *
+   * @return The pose after the moves so far.
+   */
+  AircraftState getState() const { return m_aircraft.getState(); }
+  /*
+   * @brief Getter for the map being scanned, including the scans so far.
+   *
+   * @return The GridMap.
+   */
+  const GridMap &getMap() const { return m_aircraft.getMap(); }
+  /*
+   * @brief Getter for the route.
+   *
+   * @return The moves so far, in order.
+   */
+  const std::vector<Moves> &getMoves() const { return m_moveList; }
+  /*
+   * @brief Getter for the coverage so far.
+   *
+   * @return The number of Cells scanned, including the first scan.
+   */
+  int getScannedCount() const { return m_scannedCount; }
+
+private:
+  Aircraft m_aircraft;           // Copy of the aircraft being routed
+  std::vector<Moves> m_moveList; // The route so far
+  SearchWorkspace m_workspace;   // Buffers reused by every leg search
+  CancelToken m_token;           // Stops the route early
+  int m_moveLimit = 0;           // Moves the route may use
+  int m_targetScanCount = 0;     // Cells to scan before stopping
+  int m_scannedCount = 0;        // Cells scanned so far
+};
+
+#endif
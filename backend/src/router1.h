@@ -2,9 +2,19 @@
 #define ROUTER
 
 #include "aircraft.h"
+#include "cancel.h"
+#include "traps.h"
+#include "workspace.h"
 #include <vector>
 
-enum class Moves { move_FORWARD, move_TURNLEFT, move_TURNRIGHT };
+// The side RoutePlanner tries first when flying on scans nothing new
+enum class TurnPreference { turn_LEFTFIRST, turn_RIGHTFIRST };
+
+// Where RoutePlanner goes when nothing next to it scans anything new
+enum class RepositionMode {
+  reposition_NEAREST, // The closest pose that scans a new Cell
+  reposition_TOUR     // The next unfinished cluster of a CoverageTour
+};
 
 /*
  * @brief Represents the set of functions completing the route planning
@@ -21,8 +31,20 @@ public:
    * for completion. Bounds checking ensures 0 <= searchPercentage <= 1.
    * @param moveLimit. The number of moves the Aircraft is allowed to make to
    * find a route.
+   * @param turnPreference The side to try first when turning.
+   * @param repositionMode Where to go when nothing nearby scans anything new.
+   * In tour mode the unscanned Cells are clustered and ordered once, after
+   * the first scan, so pockets are finished in one pass instead of flown
+   * back to later.
+   * @param threadCount The number of threads planning the tour; values below
+   * 1 use every hardware thread. Portfolios and fleets already run each
+   * planner on a pool thread, so the default is 1.
    */
-  RoutePlanner(Aircraft aircraft, float searchPercentage, int moveLimit);
+  RoutePlanner(
+      Aircraft aircraft, float searchPercentage, int moveLimit,
+      TurnPreference turnPreference = TurnPreference::turn_LEFTFIRST,
+      RepositionMode repositionMode = RepositionMode::reposition_NEAREST,
+      int threadCount = 1);
   /*
    * @brief A router for the Aircraft, based on a modified version of lawn
    * mowing algorithms combined with A* search. Finds a route that scans 80% of
@@ -32,9 +54,11 @@ public:
    * @read
    * https://thescipub.com/pdf/jcssp.2012.2032.2041.pdf#:~:text=algorithms,Acar%20and%20Choset%2C%202001
    *
-   * @return Nothing.
+   * @param token Stops planning early, keeping the moves so far.
+   *
+   * @return The moves, in order.
    */
-  std::vector<Moves> findRoute();
+  std::vector<Moves> findRoute(const CancelToken &token = CancelToken());
   /*
    * @brief Finds the nearest unscanned row based on manhattan distance.
    *
@@ -56,13 +80,18 @@ public:
 
 private:
   Aircraft m_aircraft; // The aircraft being routed
+  TrapTable m_traps;   // Mobility of every pose on the aircraft's map
   std::vector<Moves> m_moveList;
+  SearchWorkspace m_workspace; // Buffers reused by every repositioning search
   int m_totalMoves =
       0; // The number of moves the Aircraft uses to complete its route
   int m_moveLimit =
       0; // The maximum number of moves the Aircraft is allowed to use
   float m_searchPercentage =
       0.0; // The percentage of traversable Cells to be scanned
+  TurnPreference m_turnPreference; // The side tried first when turning
+  RepositionMode m_repositionMode; // Where to go when nothing nearby is new
+  int m_threadCount = 0;           // Threads planning the tour
 };
 
 #endif
@@ -0,0 +1,546 @@
+#include "search.h"
+#include "landmarks.h"
+#include "map.h"
+#include "state.h"
+#include "workspace.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Moves tried from every pose, in the order the router has always used
+constexpr std::array<Moves, 3> MOVE_ORDER = {
+    Moves::move_FORWARD, Moves::move_TURNLEFT, Moves::move_TURNRIGHT};
+
+/*
+ * @brief Helper function for path reconstruction. Undoes a move.
+ *
+ * @param state The pose after the move.
+ * @param move The move that was made.
+ *
+ * @return The pose before the move.
+ */
+AircraftState undoMove(const AircraftState &state, const Moves move) {
+  switch (move) {
+  case Moves::move_TURNLEFT:
+    return {state.row, state.col, turnedRight(state.dir)};
+  case Moves::move_TURNRIGHT:
+    return {state.row, state.col, turnedLeft(state.dir)};
+  case Moves::move_FORWARD:
+    break;
+  }
+  return advancedBy(state, -1);
+}
+
+/*
+ * @brief Breadth-first search over poses that stops at the first pose
+ * satisfying a goal test. Poses are tested as they are discovered, which is
+ * in order of distance, so the pose found is a closest one.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the search starts from. It is never tested itself.
+ * @param workspace The buffers the search runs in.
+ * @param isGoal Called with each discovered pose; returns true to stop.
+ * @param canEnter Called with each legal successor; returns false to keep the
+ * search from entering it.
+ *
+ * @return The id of the goal pose, or -1 if no reachable pose satisfies
+ * isGoal or the workspace's CancelToken stopped the search.
+ */
+template <typename GoalTest, typename EntryTest>
+int searchUntil(const GridMap &map, const AircraftState &start,
+                SearchWorkspace &workspace, GoalTest isGoal,
+                EntryTest canEnter) {
+  // The workspace records visited poses, the move that first reached each
+  // pose, the distance to each pose and the FIFO frontier
+  workspace.begin(stateCount(map));
+  const int startId = stateId(map, start);
+  workspace.push(startId);
+  workspace.setCost(startId, 0);
+
+  while (!workspace.frontierEmpty()) {
+    if (workspace.pollStop()) {
+      return -1;
+    }
+    const int id = workspace.pop();
+    const AircraftState state = stateFromId(map, id);
+    const int cost = workspace.getCost(id) + 1;
+    for (const Moves move : MOVE_ORDER) {
+      AircraftState next{};
+      if (!step(state, move, map, next) || !canEnter(next)) {
+        continue;
+      }
+      const int nextId = stateId(map, next);
+      if (workspace.isVisited(nextId)) {
+        continue;
+      }
+      workspace.setCost(nextId, cost);
+      if (isGoal(next)) {
+        workspace.visit(nextId, static_cast<std::uint8_t>(move));
+        return nextId;
+      }
+      workspace.push(nextId, static_cast<std::uint8_t>(move));
+    }
+  }
+  return -1;
+}
+
+// Entry test for searches that may go anywhere on the map
+bool anywhere(const AircraftState & /*state*/) { return true; }
+
+/*
+ * @brief Builds an entry test that confines a search to a rectangle of Cells.
+ *
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ *
+ * @return The entry test.
+ */
+std::function<bool(const AircraftState &)>
+insideArea(const std::array<int, 4> &area) {
+  return [area](const AircraftState &state) {
+    return state.row >= area[0] && state.col >= area[1] &&
+           state.row <= area[2] && state.col <= area[3];
+  };
+}
+
+/*
+ * @brief Rebuilds the moves of a finished search by walking the parent moves
+ * from the goal back to the start.
+ *
+ * @param map The GridMap that was searched.
+ * @param start The pose the search started from.
+ * @param goalId The id of the goal pose, or -1.
+ * @param workspace The workspace the search ran in.
+ *
+ * @return The moves from start to the goal, or an empty vector if goalId is
+ * -1.
+ */
+std::vector<Moves> rebuildPath(const GridMap &map, const AircraftState &start,
+                               const int goalId,
+                               const SearchWorkspace &workspace) {
+  std::vector<Moves> path;
+  if (goalId < 0) {
+    return path;
+  }
+  AircraftState state = stateFromId(map, goalId);
+  while (state != start) {
+    const Moves move =
+        static_cast<Moves>(workspace.getParent(stateId(map, state)));
+    path.push_back(move);
+    state = undoMove(state, move);
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+/*
+ * @brief Helper function for jumpPointPath(). Flies straight ahead from a pose
+ * and stops at the first Cell where a shortest path might need to turn.
+ *
+ * Turning anywhere else can be traded for turning at one of these Cells
+ * without lengthening the path: they are where the run lines up with the
+ * target, where it runs into a wall, where a passage opens beside it, and
+ * where a passage to either side leads to such an opening.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param state The pose the run starts from.
+ * @param targetRow The row being searched for.
+ * @param targetCol The column being searched for.
+ *
+ * @return The number of forward moves to the stopping Cell, or 0 if the
+ * aircraft cannot move forward.
+ */
+int jumpLength(const GridMap &map, const AircraftState &state,
+               const int targetRow, const int targetCol) {
+  const int dir = static_cast<int>(state.dir);
+  const int dRow = motion::FORWARD_ROW[dir];
+  const int dCol = motion::FORWARD_COL[dir];
+  const int longest = std::max(map.getRowCount(), map.getColCount());
+
+  int length = map.openRunLength(state.row, state.col, dRow, dCol, longest);
+  if (length == 0) {
+    return 0;
+  }
+  const int toTargetRow = (targetRow - state.row) * dRow;
+  const int toTargetCol = (targetCol - state.col) * dCol;
+  if (toTargetRow > 0) {
+    length = std::min(length, toTargetRow);
+  }
+  if (toTargetCol > 0) {
+    length = std::min(length, toTargetCol);
+  }
+  const int opening =
+      map.sideOpeningDistance(state.row, state.col, dRow, dCol, length);
+  if (opening > 0) {
+    length = opening;
+  }
+
+  for (int k = 1; k < length; k++) {
+    const int row = state.row + k * dRow;
+    const int col = state.col + k * dCol;
+    for (const int side : {-1, 1}) {
+      const int sideRow = side * dCol;
+      const int sideCol = side * dRow;
+      const int reach = map.openRunLength(row, col, sideRow, sideCol, longest);
+      if (reach > 0 &&
+          map.sideOpeningDistance(row, col, sideRow, sideCol, reach) > 0) {
+        return k;
+      }
+    }
+  }
+  return length;
+}
+
+/*
+ * @brief Rebuilds the moves of a finished jumpPointPath() search. A pose
+ * reached by a jump records only that it was reached moving forward, so the
+ * jump is walked back until a pose whose cost accounts for it.
+ *
+ * @param map The GridMap that was searched.
+ * @param start The pose the search started from.
+ * @param goalId The id of the goal pose, or -1.
+ * @param workspace The workspace the search ran in.
+ *
+ * @return The moves from start to the goal, or an empty vector if goalId is
+ * -1.
+ */
+std::vector<Moves> rebuildJumps(const GridMap &map, const AircraftState &start,
+                                const int goalId,
+                                const SearchWorkspace &workspace) {
+  std::vector<Moves> path;
+  if (goalId < 0) {
+    return path;
+  }
+  AircraftState state = stateFromId(map, goalId);
+  while (state != start) {
+    const int id = stateId(map, state);
+    const Moves move = static_cast<Moves>(workspace.getParent(id));
+    if (move != Moves::move_FORWARD) {
+      path.push_back(move);
+      state = undoMove(state, move);
+      continue;
+    }
+    int steps = 0;
+    int fromId = id;
+    do {
+      state = advancedBy(state, -1);
+      path.push_back(Moves::move_FORWARD);
+      steps++;
+      fromId = stateId(map, state);
+    } while (!workspace.isVisited(fromId) ||
+             workspace.getCost(fromId) + steps != workspace.getCost(id));
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+} // namespace
+
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                const int targetRow, const int targetCol,
+                                SearchWorkspace &workspace) {
+  if (start.row == targetRow && start.col == targetCol) {
+    return {};
+  }
+  const int goalId =
+      searchUntil(
+          map, start, workspace,
+          [&](const AircraftState &state) {
+            return state.row == targetRow && state.col == targetCol;
+          },
+          anywhere);
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                const int targetRow, const int targetCol,
+                                SearchWorkspace &workspace,
+                                const LandmarkTable &landmarks) {
+  const auto heuristic = [&](const AircraftState &state) {
+    return landmarks.lowerBound(state.row, state.col, targetRow, targetCol);
+  };
+
+  // Costs are integers and the heuristic is consistent, so the open set is a
+  // bucket queue indexed by f = g + h whose lowest bucket never decreases
+  workspace.begin(stateCount(map));
+  std::vector<std::vector<int>> &buckets = workspace.getBuckets();
+  const int startId = stateId(map, start);
+  workspace.visit(startId);
+  workspace.setCost(startId, 0);
+  const int startF = heuristic(start);
+  if (static_cast<int>(buckets.size()) <= startF) {
+    buckets.resize(startF + 1);
+  }
+  buckets[startF].push_back(startId);
+
+  int goalId = -1;
+  bool stopped = false;
+  std::size_t lastBucket = startF;
+  for (std::size_t f = startF; f < buckets.size() && goalId < 0 && !stopped;
+       f++) {
+    while (!buckets[f].empty() && goalId < 0) {
+      if (workspace.pollStop()) {
+        stopped = true;
+        break;
+      }
+      const int id = buckets[f].back();
+      buckets[f].pop_back();
+      const AircraftState state = stateFromId(map, id);
+      const int cost = workspace.getCost(id);
+      // Skip entries left behind when a cheaper path to the pose was found
+      if (static_cast<std::size_t>(cost + heuristic(state)) != f) {
+        continue;
+      }
+      if (state.row == targetRow && state.col == targetCol) {
+        goalId = id;
+        break;
+      }
+      for (const Moves move : MOVE_ORDER) {
+        AircraftState next{};
+        if (!step(state, move, map, next)) {
+          continue;
+        }
+        const int nextId = stateId(map, next);
+        if (workspace.isVisited(nextId) &&
+            workspace.getCost(nextId) <= cost + 1) {
+          continue;
+        }
+        workspace.visit(nextId, static_cast<std::uint8_t>(move));
+        workspace.setCost(nextId, cost + 1);
+        const std::size_t nextF = cost + 1 + heuristic(next);
+        if (buckets.size() <= nextF) {
+          buckets.resize(nextF + 1);
+        }
+        buckets[nextF].push_back(nextId);
+        lastBucket = std::max(lastBucket, nextF);
+      }
+    }
+  }
+
+  // Leave the buckets empty for the next search
+  for (std::size_t f = startF; f <= lastBucket; f++) {
+    buckets[f].clear();
+  }
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+std::vector<Moves> jumpPointPath(const GridMap &map,
+                                 const AircraftState &start,
+                                 const int targetRow, const int targetCol,
+                                 SearchWorkspace &workspace) {
+  if (start.row == targetRow && start.col == targetCol) {
+    return {};
+  }
+  const auto heuristic = [&](const AircraftState &state) {
+    return std::abs(state.row - targetRow) + std::abs(state.col - targetCol);
+  };
+
+  // A* over the poses where runs stop and the turns made there. A jump costs
+  // its length and moves the pose that far, so Manhattan distance stays a
+  // consistent heuristic and the open set is again a bucket queue.
+  workspace.begin(stateCount(map));
+  std::vector<std::vector<int>> &buckets = workspace.getBuckets();
+  const int startId = stateId(map, start);
+  workspace.visit(startId);
+  workspace.setCost(startId, 0);
+  const std::size_t startF = heuristic(start);
+  if (buckets.size() <= startF) {
+    buckets.resize(startF + 1);
+  }
+  buckets[startF].push_back(startId);
+
+  // Records a route to a pose if it beats the best known one
+  std::size_t lastBucket = startF;
+  const auto relax = [&](const AircraftState &next, const Moves move,
+                         const int cost) {
+    const int nextId = stateId(map, next);
+    if (workspace.isVisited(nextId) && workspace.getCost(nextId) <= cost) {
+      return;
+    }
+    workspace.visit(nextId, static_cast<std::uint8_t>(move));
+    workspace.setCost(nextId, cost);
+    const std::size_t nextF = cost + heuristic(next);
+    if (buckets.size() <= nextF) {
+      buckets.resize(nextF + 1);
+    }
+    buckets[nextF].push_back(nextId);
+    lastBucket = std::max(lastBucket, nextF);
+  };
+
+  int goalId = -1;
+  bool stopped = false;
+  for (std::size_t f = startF; f < buckets.size() && goalId < 0 && !stopped;
+       f++) {
+    while (!buckets[f].empty()) {
+      if (workspace.pollStop()) {
+        stopped = true;
+        break;
+      }
+      const int id = buckets[f].back();
+      buckets[f].pop_back();
+      const AircraftState state = stateFromId(map, id);
+      const int cost = workspace.getCost(id);
+      // Skip entries left behind when a cheaper path to the pose was found
+      if (static_cast<std::size_t>(cost + heuristic(state)) != f) {
+        continue;
+      }
+      if (state.row == targetRow && state.col == targetCol) {
+        goalId = id;
+        break;
+      }
+      const int jump = jumpLength(map, state, targetRow, targetCol);
+      if (jump > 0) {
+        relax(advancedBy(state, jump), Moves::move_FORWARD, cost + jump);
+      }
+      relax(applyMove(state, Moves::move_TURNLEFT), Moves::move_TURNLEFT,
+            cost + 1);
+      relax(applyMove(state, Moves::move_TURNRIGHT), Moves::move_TURNRIGHT,
+            cost + 1);
+    }
+  }
+
+  // Leave the buckets empty for the next search
+  for (std::size_t f = startF; f <= lastBucket; f++) {
+    buckets[f].clear();
+  }
+  return rebuildJumps(map, start, goalId, workspace);
+}
+
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                const int targetRow, const int targetCol) {
+  SearchWorkspace workspace;
+  return shortestPath(map, start, targetRow, targetCol, workspace);
+}
+
+std::vector<Moves> pathToNewScan(const GridMap &map,
+                                 const AircraftState &start,
+                                 SearchWorkspace &workspace) {
+  const int goalId =
+      searchUntil(
+          map, start, workspace,
+          [&](const AircraftState &state) {
+            return footprintGain(map, state) > 0;
+          },
+          anywhere);
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+std::vector<Moves> pathToScanWithin(const GridMap &map,
+                                    const AircraftState &start,
+                                    const std::array<int, 4> &area,
+                                    SearchWorkspace &workspace) {
+  const auto scansArea = [&](const AircraftState &state) {
+    const std::array<int, 4> scan = scanFootprint(state);
+    for (int row = std::max(scan[0], area[0]);
+         row <= std::min(scan[2], area[2]); row++) {
+      for (int col = std::max(scan[1], area[1]);
+           col <= std::min(scan[3], area[3]); col++) {
+        if (map.canOccupy(row, col) && !map.isScanned(row, col)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+  const int goalId = searchUntil(map, start, workspace, scansArea, anywhere);
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+std::vector<Moves> shortestPathWithin(const GridMap &map,
+                                      const AircraftState &start,
+                                      const int targetRow, const int targetCol,
+                                      const std::array<int, 4> &area,
+                                      SearchWorkspace &workspace) {
+  if (start.row == targetRow && start.col == targetCol) {
+    return {};
+  }
+  const int goalId = searchUntil(
+      map, start, workspace,
+      [&](const AircraftState &state) {
+        return state.row == targetRow && state.col == targetCol;
+      },
+      insideArea(area));
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+void searchWithin(const GridMap &map, const AircraftState &start,
+                  const std::array<int, 4> &area, SearchWorkspace &workspace) {
+  searchUntil(
+      map, start, workspace, [](const AircraftState & /*state*/) {
+        return false;
+      },
+      insideArea(area));
+}
+
+std::vector<Moves> pathFromSearch(const GridMap &map,
+                                  const AircraftState &start,
+                                  const AircraftState &goal,
+                                  const SearchWorkspace &workspace) {
+  const int goalId = stateId(map, goal);
+  if (!workspace.isVisited(goalId)) {
+    return {};
+  }
+  return rebuildPath(map, start, goalId, workspace);
+}
+
+void searchToCellWithin(const GridMap &map, const int targetRow,
+                        const int targetCol, const std::array<int, 4> &area,
+                        SearchWorkspace &workspace) {
+  // Search backwards from every pose on the target Cell. Each pose records
+  // the move that takes it one step closer to the target.
+  workspace.begin(stateCount(map));
+  for (int dir = 0; dir < 4; dir++) {
+    const Direction facing = static_cast<Direction>(dir);
+    const int id = stateId(map, makeState(targetRow, targetCol, facing));
+    workspace.push(id);
+    workspace.setCost(id, 0);
+  }
+  const auto inside = insideArea(area);
+
+  while (!workspace.frontierEmpty()) {
+    const int id = workspace.pop();
+    const AircraftState state = stateFromId(map, id);
+    const int cost = workspace.getCost(id) + 1;
+    // The poses one move before this one
+    const std::array<std::pair<AircraftState, Moves>, 3> previous = {{
+        {undoMove(state, Moves::move_FORWARD), Moves::move_FORWARD},
+        {undoMove(state, Moves::move_TURNLEFT), Moves::move_TURNLEFT},
+        {undoMove(state, Moves::move_TURNRIGHT), Moves::move_TURNRIGHT},
+    }};
+    for (const auto &entry : previous) {
+      const AircraftState &prev = entry.first;
+      if (!map.canOccupy(prev.row, prev.col) || !inside(prev)) {
+        continue;
+      }
+      const int prevId = stateId(map, prev);
+      if (!workspace.isVisited(prevId)) {
+        workspace.push(prevId, static_cast<std::uint8_t>(entry.second));
+        workspace.setCost(prevId, cost);
+      }
+    }
+  }
+}
+
+std::vector<Moves> pathToSearchedCell(const GridMap &map,
+                                      const AircraftState &start,
+                                      const SearchWorkspace &workspace) {
+  std::vector<Moves> path;
+  int id = stateId(map, start);
+  if (!workspace.isVisited(id)) {
+    return path;
+  }
+  AircraftState state = start;
+  while (workspace.getCost(id) > 0) {
+    const Moves move = static_cast<Moves>(workspace.getParent(id));
+    path.push_back(move);
+    state = applyMove(state, move);
+    id = stateId(map, state);
+  }
+  return path;
+}
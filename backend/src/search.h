@@ -0,0 +1,251 @@
+#ifndef SEARCH
+#define SEARCH
+
+#include "landmarks.h"
+#include "map.h"
+#include "state.h"
+#include "workspace.h"
+#include <array>
+#include <vector>
+
+/*
+ * Shortest paths over the aircraft's (row, column, Direction) state space.
+ *
+ * Every move costs 1, so a breadth-first search returns optimal paths. Poses
+ * are numbered densely as (row * columns + column) * 4 + Direction, which lets
+ * the search keep its visited set, parent moves and frontier in the flat
+ * arrays of a reusable SearchWorkspace instead of per-node containers.
+ */
+
+/*
+ * @brief The number of poses on a map.
+ *
+ * @param map The GridMap being searched.
+ *
+ * @return Rows * columns * 4.
+ */
+inline int stateCount(const GridMap &map) {
+  return map.getRowCount() * map.getColCount() * 4;
+}
+
+/*
+ * @brief The dense id of a pose. The pose must be on the map.
+ *
+ * @param map The GridMap being searched.
+ * @param state The pose.
+ *
+ * @return A value in [0, stateCount(map)).
+ */
+inline int stateId(const GridMap &map, const AircraftState &state) {
+  return (state.row * map.getColCount() + state.col) * 4 +
+         static_cast<int>(state.dir);
+}
+
+/*
+ * @brief The pose with a given dense id.
+ *
+ * @param map The GridMap being searched.
+ * @param id A value in [0, stateCount(map)).
+ *
+ * @return The pose.
+ */
+inline AircraftState stateFromId(const GridMap &map, const int id) {
+  const int cell = id / 4;
+  return makeState(cell / map.getColCount(), cell % map.getColCount(),
+                   static_cast<Direction>(id % 4));
+}
+
+/*
+ * @brief Finds a shortest sequence of moves that takes the aircraft from a
+ * pose to a Cell, facing any Direction.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the path starts from. Must be on the map.
+ * @param targetRow The row to reach.
+ * @param targetCol The column to reach.
+ * @param workspace The buffers the search runs in. Reusing one workspace
+ * across searches avoids allocating and clearing them every call.
+ *
+ * @return The moves, in order. Empty if the aircraft is already on the target
+ * Cell or the target cannot be reached.
+ */
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                int targetRow, int targetCol,
+                                SearchWorkspace &workspace);
+/*
+ * @brief Finds a shortest path like shortestPath(), but with A* guided by
+ * landmark distances. On maps with walls and canyons this expands far fewer
+ * poses than breadth-first search; the paths are equally short.
+ *
+ * @param map The GridMap the aircraft exists on. Must have the terrain the
+ * landmarks were built on.
+ * @param start The pose the path starts from. Must be on the map.
+ * @param targetRow The row to reach.
+ * @param targetCol The column to reach.
+ * @param workspace The buffers the search runs in.
+ * @param landmarks The precomputed landmark distances. Build them once and
+ * reuse them for every query on the map.
+ *
+ * @return The moves, in order. Empty if the aircraft is already on the target
+ * Cell, the target cannot be reached or the workspace's CancelToken stopped
+ * the search.
+ */
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                int targetRow, int targetCol,
+                                SearchWorkspace &workspace,
+                                const LandmarkTable &landmarks);
+/*
+ * @brief Finds a shortest path like shortestPath(), but with jump point
+ * search adapted to the aircraft's forward and turn moves.
+ *
+ * Rather than stepping one Cell at a time, each pose flies straight until
+ * its run lines up with the target, meets a wall, or passes a side passage
+ * that a shortest path might need to turn into, and only the poses where
+ * runs stop are queued. On open maps this queues a tiny fraction of the
+ * poses breadth-first search visits. The paths are equally short.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the path starts from. Must be on the map.
+ * @param targetRow The row to reach.
+ * @param targetCol The column to reach.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return The moves, in order. Empty if the aircraft is already on the target
+ * Cell, the target cannot be reached or the workspace's CancelToken stopped
+ * the search.
+ */
+std::vector<Moves> jumpPointPath(const GridMap &map,
+                                 const AircraftState &start, int targetRow,
+                                 int targetCol, SearchWorkspace &workspace);
+/*
+ * @brief Convenience overload of shortestPath() that runs in a temporary
+ * workspace.
+ */
+std::vector<Moves> shortestPath(const GridMap &map, const AircraftState &start,
+                                int targetRow, int targetCol);
+
+/*
+ * @brief Finds the closest pose, by number of moves, whose scan would cover at
+ * least one traversable, unscanned Cell, and the moves that reach it.
+ *
+ * Choosing a target and finding the path to it are a single search through
+ * the turn-constrained pose graph, so a target behind a wall never wins over
+ * one that is truly closer.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the search starts from. Its own scan is not
+ * considered.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return The moves, in order. Empty if no reachable pose would scan a new
+ * Cell or the workspace's CancelToken stopped the search.
+ */
+std::vector<Moves> pathToNewScan(const GridMap &map,
+                                 const AircraftState &start,
+                                 SearchWorkspace &workspace);
+
+/*
+ * @brief Finds the closest pose, by number of moves, whose scan would cover
+ * a traversable, unscanned Cell inside a rectangle, and the moves that reach
+ * it. The path itself may leave the rectangle.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the search starts from. Its own scan is not
+ * considered.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return The moves, in order. Empty if no reachable pose would scan a new
+ * Cell of the rectangle or the workspace's CancelToken stopped the search.
+ */
+std::vector<Moves> pathToScanWithin(const GridMap &map,
+                                    const AircraftState &start,
+                                    const std::array<int, 4> &area,
+                                    SearchWorkspace &workspace);
+
+/*
+ * @brief Finds a shortest path to a Cell that never leaves a rectangle of
+ * Cells.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the path starts from. Must be inside the area.
+ * @param targetRow The row to reach.
+ * @param targetCol The column to reach.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return The moves, in order. Empty if the aircraft is already on the target
+ * Cell or the target cannot be reached inside the area.
+ */
+std::vector<Moves> shortestPathWithin(const GridMap &map,
+                                      const AircraftState &start,
+                                      int targetRow, int targetCol,
+                                      const std::array<int, 4> &area,
+                                      SearchWorkspace &workspace);
+
+/*
+ * @brief Measures the distance from a pose to every pose reachable inside a
+ * rectangle of Cells. Afterwards SearchWorkspace::isVisited() tells whether
+ * a pose id was reached and getCost() gives its distance.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param start The pose the search starts from. Must be inside the area.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return Nothing.
+ */
+void searchWithin(const GridMap &map, const AircraftState &start,
+                  const std::array<int, 4> &area, SearchWorkspace &workspace);
+
+/*
+ * @brief Rebuilds the moves to a pose reached by the last searchWithin() run
+ * in a workspace.
+ *
+ * @param map The GridMap that was searched.
+ * @param start The pose the search started from.
+ * @param goal The pose to rebuild the path to.
+ * @param workspace The workspace the search ran in.
+ *
+ * @return The moves, in order. Empty if goal was not reached.
+ */
+std::vector<Moves> pathFromSearch(const GridMap &map,
+                                  const AircraftState &start,
+                                  const AircraftState &goal,
+                                  const SearchWorkspace &workspace);
+
+/*
+ * @brief Measures the distance from every pose inside a rectangle of Cells to
+ * a target Cell, by searching backwards from the target. Afterwards
+ * SearchWorkspace::isVisited() tells whether a pose id can reach the target
+ * and getCost() gives its distance.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param targetRow The row of the target Cell. Must be traversable.
+ * @param targetCol The column of the target Cell.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * Must contain the target.
+ * @param workspace The buffers the search runs in.
+ *
+ * @return Nothing.
+ */
+void searchToCellWithin(const GridMap &map, int targetRow, int targetCol,
+                        const std::array<int, 4> &area,
+                        SearchWorkspace &workspace);
+
+/*
+ * @brief Rebuilds the moves from a pose to the target of the last
+ * searchToCellWithin() run in a workspace.
+ *
+ * @param map The GridMap that was searched.
+ * @param start The pose to start from.
+ * @param workspace The workspace the search ran in.
+ *
+ * @return The moves, in order. Empty if start is on the target or cannot
+ * reach it.
+ */
+std::vector<Moves> pathToSearchedCell(const GridMap &map,
+                                      const AircraftState &start,
+                                      const SearchWorkspace &workspace);
+
+#endif
@@ -0,0 +1,348 @@
+#include "spanningtree.h"
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "planner.h"
+#include "routebuilder.h"
+#include "state.h"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// A subcell is the width of the scanner, and a block is two subcells across
+constexpr int SUBCELL_SIZE = 3;
+constexpr int BLOCK_SIZE = 2 * SUBCELL_SIZE;
+
+// Every Direction, in the order the circuit and the search try them
+constexpr std::array<Direction, 4> DIRECTIONS = {
+    {Direction::dir_NORTH, Direction::dir_SOUTH, Direction::dir_EAST,
+     Direction::dir_WEST}};
+
+/*
+ * @brief Helper function for the spanning tree. The opposite of a Direction.
+ *
+ * @param dir The Direction.
+ *
+ * @return The Direction after an about-face.
+ */
+Direction reversed(const Direction dir) {
+  return static_cast<Direction>(static_cast<int>(dir) ^ 1);
+}
+
+/*
+ * @brief Helper function for buildSpanningForest(). Determines if the line
+ * from one subcell centre to the next can be flown.
+ *
+ * @param map The GridMap being covered.
+ * @param row The row of the first centre.
+ * @param col The column of the first centre.
+ * @param dRow The row step towards the second centre (0 or 1).
+ * @param dCol The column step towards the second centre (0 or 1).
+ *
+ * @return True if every Cell on the line is traversable, else false.
+ */
+bool lineOpen(const GridMap &map, const int row, const int col, const int dRow,
+              const int dCol) {
+  return map.canOccupy(row, col) &&
+         map.openRunLength(row, col, dRow, dCol, SUBCELL_SIZE) ==
+             SUBCELL_SIZE;
+}
+
+/*
+ * @brief Helper function for buildSpanningForest(). Determines if a block can
+ * be circled: the square through its four subcell centres can be flown.
+ *
+ * @param map The GridMap being covered.
+ * @param blockRow The row of the block.
+ * @param blockCol The column of the block.
+ *
+ * @return True if the block is usable, else false.
+ */
+bool blockUsable(const GridMap &map, const int blockRow, const int blockCol) {
+  const int top = blockRow * BLOCK_SIZE + 1;
+  const int left = blockCol * BLOCK_SIZE + 1;
+  const int bottom = top + SUBCELL_SIZE;
+  const int right = left + SUBCELL_SIZE;
+  return lineOpen(map, top, left, 0, 1) && lineOpen(map, bottom, left, 0, 1) &&
+         lineOpen(map, top, left, 1, 0) && lineOpen(map, top, right, 1, 0);
+}
+
+/*
+ * @brief Helper function for buildSpanningForest(). Determines if a block can
+ * be joined to the next block east or south: both lines between their facing
+ * subcell centres can be flown.
+ *
+ * @param map The GridMap being covered.
+ * @param blockRow The row of the block.
+ * @param blockCol The column of the block.
+ * @param dir dir_EAST or dir_SOUTH.
+ *
+ * @return True if the two blocks can be joined, else false.
+ */
+bool joinable(const GridMap &map, const int blockRow, const int blockCol,
+              const Direction dir) {
+  const int top = blockRow * BLOCK_SIZE + 1;
+  const int left = blockCol * BLOCK_SIZE + 1;
+  if (dir == Direction::dir_EAST) {
+    const int col = left + SUBCELL_SIZE;
+    return lineOpen(map, top, col, 0, 1) &&
+           lineOpen(map, top + SUBCELL_SIZE, col, 0, 1);
+  }
+  const int row = top + SUBCELL_SIZE;
+  return lineOpen(map, row, left, 1, 0) &&
+         lineOpen(map, row, left + SUBCELL_SIZE, 1, 0);
+}
+
+/*
+ * @brief Helper function for SpanningTreePlanner. Finds the Direction in
+ * which the circuit around a tree leaves a subcell, other than back the way
+ * it came.
+ *
+ * Subcells are numbered on a grid twice as fine as the blocks. A step inside
+ * a block is on the circuit unless a tree edge crosses it, and a step into
+ * another block is on the circuit only alongside a tree edge, which makes
+ * every subcell of a tree have exactly two steps.
+ *
+ * @param forest The spanning forest.
+ * @param row The row of the subcell.
+ * @param col The column of the subcell.
+ * @param from The Direction of the step that reached the subcell.
+ * @param first True to skip the check against from.
+ *
+ * @return The Direction of the next step.
+ */
+Direction circuitStep(const SpanningForest &forest, const int row,
+                      const int col, const Direction from, const bool first) {
+  const int block = (row / 2) * forest.blockCols + col / 2;
+  for (const Direction dir : DIRECTIONS) {
+    if (!first && dir == reversed(from)) {
+      continue;
+    }
+    // The step stays in the block when it moves towards the block's middle,
+    // where it would cross the tree edge on the subcell's side of the block
+    bool inside = false;
+    Direction crossing = dir;
+    switch (dir) {
+    case Direction::dir_NORTH:
+    case Direction::dir_SOUTH:
+      inside = (row % 2 == 0) == (dir == Direction::dir_SOUTH);
+      crossing = col % 2 == 0 ? Direction::dir_WEST : Direction::dir_EAST;
+      break;
+    case Direction::dir_EAST:
+    case Direction::dir_WEST:
+      inside = (col % 2 == 0) == (dir == Direction::dir_EAST);
+      crossing = row % 2 == 0 ? Direction::dir_NORTH : Direction::dir_SOUTH;
+      break;
+    }
+    if (inside ? !forest.hasEdge(block, crossing)
+               : forest.hasEdge(block, dir)) {
+      return dir;
+    }
+  }
+  return from; // Unreachable for a subcell of a tree
+}
+
+/*
+ * @brief Helper function for SpanningTreePlanner. The number of quarter turns
+ * between two Directions.
+ *
+ * @param from The current Direction.
+ * @param to The Direction to face.
+ *
+ * @return 0, 1 or 2.
+ */
+int turnCount(const Direction from, const Direction to) {
+  if (from == to) {
+    return 0;
+  }
+  return to == reversed(from) ? 2 : 1;
+}
+
+/*
+ * @brief Helper function for SpanningTreePlanner's findRoute(). Flies the
+ * circuit around one tree, merging consecutive steps in the same Direction
+ * into one straight run.
+ *
+ * @param forest The spanning forest.
+ * @param row The row of the subcell the circuit starts from.
+ * @param col The column of the subcell the circuit starts from.
+ * @param route The route being built. The aircraft must be at the centre of
+ * the starting subcell.
+ *
+ * @return Nothing.
+ */
+void flyCircuit(const SpanningForest &forest, int row, int col,
+                RouteBuilder &route) {
+  // Leave the first subcell in whichever circuit Direction is the fewer turns
+  // away from the current heading
+  const Direction heading = route.getState().dir;
+  Direction dir = circuitStep(forest, row, col, heading, true);
+  const Direction other =
+      circuitStep(forest, row, col, reversed(dir), false);
+  if (turnCount(heading, other) < turnCount(heading, dir)) {
+    dir = other;
+  }
+
+  const int startRow = row;
+  const int startCol = col;
+  int steps = 0;
+  do {
+    const int dirIndex = static_cast<int>(dir);
+    row += motion::FORWARD_ROW[dirIndex];
+    col += motion::FORWARD_COL[dirIndex];
+    steps++;
+    const Direction next = circuitStep(forest, row, col, dir, false);
+    if (next != dir || (row == startRow && col == startCol)) {
+      if (!route.routing()) {
+        return;
+      }
+      route.flyTo(route.getState().row, route.getState().col, dir);
+      route.flyStraight(steps * SUBCELL_SIZE);
+      steps = 0;
+      dir = next;
+    }
+  } while (row != startRow || col != startCol);
+}
+
+} // namespace
+
+SpanningForest buildSpanningForest(const GridMap &map) {
+  SpanningForest forest;
+  forest.blockRows = (map.getRowCount() - 1) / BLOCK_SIZE + 1;
+  forest.blockCols = (map.getColCount() - 1) / BLOCK_SIZE + 1;
+  const int blockCount = forest.blockRows * forest.blockCols;
+  forest.edges.assign(blockCount, 0);
+
+  // -2 marks a usable block not yet in a tree
+  forest.trees.assign(blockCount, -1);
+  for (int block = 0; block < blockCount; block++) {
+    const int top = (block / forest.blockCols) * BLOCK_SIZE;
+    const int left = (block % forest.blockCols) * BLOCK_SIZE;
+    // Blocks scanned before planning (by another aircraft, say) are left out
+    if (blockUsable(map, block / forest.blockCols, block % forest.blockCols) &&
+        map.scanAreaGain(top, left, top + BLOCK_SIZE - 1,
+                         left + BLOCK_SIZE - 1) > 0) {
+      forest.trees[block] = -2;
+    }
+  }
+
+  const auto canJoin = [&](const int block, const Direction dir) {
+    const int blockRow = block / forest.blockCols;
+    const int blockCol = block % forest.blockCols;
+    switch (dir) {
+    case Direction::dir_NORTH:
+      return blockRow > 0 &&
+             joinable(map, blockRow - 1, blockCol, Direction::dir_SOUTH);
+    case Direction::dir_SOUTH:
+      return blockRow + 1 < forest.blockRows &&
+             joinable(map, blockRow, blockCol, Direction::dir_SOUTH);
+    case Direction::dir_EAST:
+      return blockCol + 1 < forest.blockCols &&
+             joinable(map, blockRow, blockCol, Direction::dir_EAST);
+    case Direction::dir_WEST:
+      return blockCol > 0 &&
+             joinable(map, blockRow, blockCol - 1, Direction::dir_EAST);
+    }
+    return false;
+  };
+
+  const auto neighbourOf = [&](const int block, const Direction dir) {
+    return block + motion::FORWARD_ROW[static_cast<int>(dir)] *
+                       forest.blockCols +
+           motion::FORWARD_COL[static_cast<int>(dir)];
+  };
+
+  // Each stack entry is a block and the Direction of the edge that reached
+  // it. Blocks join a tree when popped, so a block pushed twice keeps the
+  // edge of its last push, which is the depth-first one.
+  std::vector<std::pair<int, Direction>> stack;
+  for (int root = 0; root < blockCount; root++) {
+    if (forest.trees[root] != -2) {
+      continue;
+    }
+    const int tree = forest.treeCount++;
+    stack.emplace_back(root, Direction::dir_NORTH);
+    while (!stack.empty()) {
+      const int block = stack.back().first;
+      const Direction from = stack.back().second;
+      stack.pop_back();
+      if (forest.trees[block] != -2) {
+        continue;
+      }
+      forest.trees[block] = tree;
+      if (block != root) {
+        const int parent = neighbourOf(block, reversed(from));
+        forest.edges[parent] |= 1 << static_cast<int>(from);
+        forest.edges[block] |= 1 << static_cast<int>(reversed(from));
+      }
+      // Push the straight step last so that it is popped first
+      for (const Direction dir : DIRECTIONS) {
+        if ((dir != from || block == root) && canJoin(block, dir) &&
+            forest.trees[neighbourOf(block, dir)] == -2) {
+          stack.emplace_back(neighbourOf(block, dir), dir);
+        }
+      }
+      if (block != root && canJoin(block, from) &&
+          forest.trees[neighbourOf(block, from)] == -2) {
+        stack.emplace_back(neighbourOf(block, from), from);
+      }
+    }
+  }
+  return forest;
+}
+
+SpanningTreePlanner::SpanningTreePlanner(Aircraft aircraft,
+                                         float searchPercentage, int moveLimit)
+    : m_aircraft(aircraft), m_moveLimit(clampMoveLimit(moveLimit)),
+      m_searchPercentage(clampSearchPercentage(searchPercentage)) {
+  m_forest = buildSpanningForest(m_aircraft.getMap());
+  for (const int tree : m_forest.trees) {
+    m_blockCount += tree >= 0 ? 1 : 0;
+  }
+}
+
+std::vector<Moves> SpanningTreePlanner::findRoute(const CancelToken &token) {
+  RouteBuilder route(m_aircraft, m_searchPercentage, m_moveLimit, token);
+  const int subcellCols = 2 * m_forest.blockCols;
+  const int subcellCount = 4 * m_forest.blockRows * m_forest.blockCols;
+
+  // Fly the trees nearest first, each from its subcell closest to the
+  // aircraft
+  std::vector<bool> flown(m_forest.treeCount, false);
+  while (route.routing()) {
+    const AircraftState state = route.getState();
+    int start = -1;
+    int startDistance = 0;
+    for (int subcell = 0; subcell < subcellCount; subcell++) {
+      const int row = subcell / subcellCols;
+      const int col = subcell % subcellCols;
+      const int tree = m_forest.trees[(row / 2) * m_forest.blockCols + col / 2];
+      if (tree < 0 || flown[tree]) {
+        continue;
+      }
+      const int distance = std::abs(state.row - (row * SUBCELL_SIZE + 1)) +
+                           std::abs(state.col - (col * SUBCELL_SIZE + 1));
+      if (start < 0 || distance < startDistance) {
+        start = subcell;
+        startDistance = distance;
+      }
+    }
+    if (start < 0) {
+      break; // Every tree is flown
+    }
+    const int row = start / subcellCols;
+    const int col = start % subcellCols;
+    flown[m_forest.trees[(row / 2) * m_forest.blockCols + col / 2]] = true;
+    if (route.flyTo(row * SUBCELL_SIZE + 1, col * SUBCELL_SIZE + 1,
+                    state.dir)) {
+      flyCircuit(m_forest, row, col, route);
+    }
+  }
+
+  route.pickUpMissed();
+  return route.getMoves();
+}
@@ -0,0 +1,115 @@
+#ifndef SPANNINGTREE
+#define SPANNINGTREE
+
+#include "aircraft.h"
+#include "cancel.h"
+#include "map.h"
+#include "state.h"
+#include <cstdint>
+#include <vector>
+
+/*
+ * @brief A spanning forest over the macro grid of a map. The map is cut into
+ * 6x6 blocks, each made of four 3x3 subcells the width of the scanner. A
+ * block is usable when the square joining its four subcell centres can be
+ * flown and it still holds an unscanned Cell, and two usable blocks can be
+ * joined when both lines between their subcell centres can be flown.
+ */
+struct SpanningForest {
+  int blockRows = 0;               // Number of rows of blocks
+  int blockCols = 0;               // Number of columns of blocks
+  int treeCount = 0;               // Number of trees in the forest
+  std::vector<int> trees;          // Tree of each block, -1 if unusable
+  std::vector<std::uint8_t> edges; // Tree edges of each block by Direction
+
+  /*
+   * @brief Determines if a block has a tree edge in a Direction.
+   *
+   * @param block The index of the block (row * blockCols + col).
+   * @param dir The Direction of the edge.
+   *
+   * @return True if the edge is in the forest, else false.
+   */
+  bool hasEdge(const int block, const Direction dir) const {
+    return (edges[block] >> static_cast<int>(dir)) & 1;
+  }
+};
+
+/*
+ * @brief Builds a spanning forest of the usable blocks of a map with a depth
+ * first search that keeps going straight whenever it can, so that the trees
+ * have long branches and the circuits around them turn rarely.
+ *
+ * @param map The GridMap being covered.
+ *
+ * @return One tree per connected group of usable blocks.
+ */
+SpanningForest buildSpanningForest(const GridMap &map);
+
+/*
+ * @brief A coverage planner that flies around spanning trees of the macro
+ * grid (spanning-tree coverage).
+ *
+ * The circuit around a tree of n blocks passes through the centre of each of
+ * its 4n subcells once, so it scans every usable block in at most 12n forward
+ * moves and 4n quarter turns. Trees are flown nearest first, the legs between
+ * them are found with jump point search, and RouteBuilder::pickUpMissed()
+ * collects the Cells that lie outside usable blocks.
+ *
+ * @read https://doi.org/10.1023/A:1016610507833
+ */
+class SpanningTreePlanner {
+public:
+  /*
+   * @brief Constructor for the SpanningTreePlanner class. Builds the spanning
+   * forest of the Aircraft's map.
+   *
+   * @param aircraft The Aircraft being routed.
+   * @param searchPercentage The percentage of traversable cells to be searched
+   * for completion. Bounds checking ensures 0.01 <= searchPercentage <= 1.
+   * @param moveLimit The number of moves the Aircraft is allowed to make.
+   *
+   * @return Nothing.
+   */
+  SpanningTreePlanner(Aircraft aircraft, float searchPercentage,
+                      int moveLimit);
+
+  /*
+   * @brief Plans the route. Stops as soon as the coverage target is met, the
+   * move limit is reached or the CancelToken asks it to stop.
+   *
+   * @param token Stops planning early, keeping the moves so far.
+   *
+   * @return The moves, in order.
+   */
+  std::vector<Moves> findRoute(const CancelToken &token = CancelToken());
+
+  /*
+   * @brief Getter for the number of usable blocks.
+   *
+   * @return The number of blocks in the forest.
+   */
+  int getBlockCount() const { return m_blockCount; }
+  /*
+   * @brief Getter for the number of trees in the forest.
+   *
+   * @return The number of trees.
+   */
+  int getTreeCount() const { return m_forest.treeCount; }
+  /*
+   * @brief Getter for the length of the circuits around every tree, the
+   * part of the route that does not depend on the legs between trees.
+   *
+   * @return An upper bound on the moves spent circling trees.
+   */
+  int getCircuitBound() const { return 16 * m_blockCount; }
+
+private:
+  Aircraft m_aircraft;            // The aircraft being routed
+  SpanningForest m_forest;        // Spanning forest of the aircraft's map
+  int m_blockCount = 0;           // Usable blocks in the forest
+  int m_moveLimit = 0;            // Moves the aircraft may use
+  float m_searchPercentage = 0.0; // Fraction of Cells to scan
+};
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef STATE
+#define STATE
+
+#include "map.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Defined directions for the aircraft to be facing
+enum class Direction {
+  dir_NORTH = 0,
+  dir_SOUTH = 1,
+  dir_EAST = 2,
+  dir_WEST = 3
+};
+
+// Used for debugging
+inline std::ostream &operator<<(std::ostream &os, const Direction dir) {
+  switch (dir) {
+  case Direction::dir_NORTH:
+    os << "NORTH";
+    break;
+  case Direction::dir_SOUTH:
+    os << "SOUTH";
+    break;
+  case Direction::dir_EAST:
+    os << "EAST";
+    break;
+  case Direction::dir_WEST:
+    os << "WEST";
+    break;
+  }
+  return os;
+}
+
+// The moves an aircraft can make. Turns happen in place.
+enum class Moves { move_FORWARD, move_TURNLEFT, move_TURNRIGHT };
+
+/*
+ * @brief The pose of an aircraft: 0-indexed row and column plus the Direction
+ * it faces.
+ *
+ * Packed into 8 bytes so that planners can copy, store and compare poses
+ * freely. Rows and columns are limited to 32767, which GridMap enforces
+ * through MAX_MAP_EXTENT.
+ */
+struct AircraftState {
+  std::int16_t row;
+  std::int16_t col;
+  Direction dir;
+};
+
+static_assert(sizeof(AircraftState) == 8, "AircraftState must stay packed");
+
+/*
+ * @brief Builds an AircraftState from int coordinates.
+ *
+ * @param row The 0-indexed row.
+ * @param col The 0-indexed column.
+ * @param dir The Direction faced.
+ *
+ * @return The pose.
+ */
+constexpr AircraftState makeState(const int row, const int col,
+                                  const Direction dir) {
+  return {static_cast<std::int16_t>(row), static_cast<std::int16_t>(col), dir};
+}
+
+constexpr bool operator==(const AircraftState &a, const AircraftState &b) {
+  return a.row == b.row && a.col == b.col && a.dir == b.dir;
+}
+
+constexpr bool operator!=(const AircraftState &a, const AircraftState &b) {
+  return !(a == b);
+}
+
+// Transition tables, indexed by the value of a Direction
+namespace motion {
+constexpr std::array<Direction, 4> LEFT_OF = {
+    Direction::dir_WEST, Direction::dir_EAST, Direction::dir_NORTH,
+    Direction::dir_SOUTH};
+constexpr std::array<Direction, 4> RIGHT_OF = {
+    Direction::dir_EAST, Direction::dir_WEST, Direction::dir_SOUTH,
+    Direction::dir_NORTH};
+constexpr std::array<int, 4> FORWARD_ROW = {-1, 1, 0, 0};
+constexpr std::array<int, 4> FORWARD_COL = {0, 0, 1, -1};
+
+// Scanner footprint as {firstRow, firstCol, lastRow, lastCol} offsets. The
+// aircraft scans the 2x3 rectangle directly ahead of it.
+constexpr std::array<std::array<int, 4>, 4> FOOTPRINT = {{
+    {{-2, -1, -1, 1}}, // NORTH: rows -2, -1; columns -1, 0, 1
+    {{1, -1, 2, 1}},   // SOUTH: rows 1, 2; columns -1, 0, 1
+    {{-1, 1, 1, 2}},   // EAST: rows -1, 0, 1; columns 1, 2
+    {{-1, -2, 1, -1}}, // WEST: rows -1, 0, 1; columns -2, -1
+}};
+} // namespace motion
+
+/*
+ * @brief The Direction after turning left.
+ *
+ * @param dir The current Direction.
+ *
+ * @return The Direction after the turn.
+ */
+constexpr Direction turnedLeft(const Direction dir) {
+  return motion::LEFT_OF[static_cast<int>(dir)];
+}
+
+/*
+ * @brief The Direction after turning right.
+ *
+ * @param dir The current Direction.
+ *
+ * @return The Direction after the turn.
+ */
+constexpr Direction turnedRight(const Direction dir) {
+  return motion::RIGHT_OF[static_cast<int>(dir)];
+}
+
+/*
+ * @brief The turns that take one Direction to another.
+ *
+ * @param from The current Direction.
+ * @param to The Direction to face.
+ *
+ * @return No moves, one turn, or two turns for an about-face.
+ */
+inline std::vector<Moves> turnsBetween(const Direction from,
+                                       const Direction to) {
+  if (from == to) {
+    return {};
+  }
+  if (turnedLeft(from) == to) {
+    return {Moves::move_TURNLEFT};
+  }
+  if (turnedRight(from) == to) {
+    return {Moves::move_TURNRIGHT};
+  }
+  return {Moves::move_TURNRIGHT, Moves::move_TURNRIGHT};
+}
+
+/*
+ * @brief Applies a move without checking it against a map.
+ *
+ * @param state The current pose.
+ * @param move The move being made.
+ *
+ * @return The pose after the move.
+ */
+constexpr AircraftState applyMove(const AircraftState &state,
+                                  const Moves move) {
+  switch (move) {
+  case Moves::move_TURNLEFT:
+    return {state.row, state.col, turnedLeft(state.dir)};
+  case Moves::move_TURNRIGHT:
+    return {state.row, state.col, turnedRight(state.dir)};
+  case Moves::move_FORWARD:
+    break;
+  }
+  const int dir = static_cast<int>(state.dir);
+  return {static_cast<std::int16_t>(state.row + motion::FORWARD_ROW[dir]),
+          static_cast<std::int16_t>(state.col + motion::FORWARD_COL[dir]),
+          state.dir};
+}
+
+/*
+ * @brief Moves a pose straight ahead without checking it against a map.
+ *
+ * @param state The current pose.
+ * @param steps The number of forward moves.
+ *
+ * @return The pose after the moves.
+ */
+constexpr AircraftState advancedBy(const AircraftState &state,
+                                   const int steps) {
+  const int dir = static_cast<int>(state.dir);
+  return makeState(state.row + steps * motion::FORWARD_ROW[dir],
+                   state.col + steps * motion::FORWARD_COL[dir], state.dir);
+}
+
+/*
+ * @brief Applies a move if it is legal on a map. Turning in place is always
+ * legal; moving forward must stay on the map and land on a traversable Cell.
+ *
+ * @param state The current pose.
+ * @param move The move being made.
+ * @param map The GridMap the aircraft exists on.
+ * @param next Filled with the pose after the move when it is legal.
+ *
+ * @return True if the move is legal, else false. Never throws.
+ */
+inline bool step(const AircraftState &state, const Moves move,
+                 const GridMap &map, AircraftState &next) {
+  const AircraftState moved = applyMove(state, move);
+  if (move == Moves::move_FORWARD && !map.canOccupy(moved.row, moved.col)) {
+    return false;
+  }
+  next = moved;
+  return true;
+}
+
+/*
+ * @brief The rectangle scanned from a pose.
+ *
+ * @param state The pose scanning.
+ *
+ * @return The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle. It
+ * may extend past the edges of the map.
+ */
+constexpr std::array<int, 4> scanFootprint(const AircraftState &state) {
+  const int dir = static_cast<int>(state.dir);
+  return {{state.row + motion::FOOTPRINT[dir][0],
+           state.col + motion::FOOTPRINT[dir][1],
+           state.row + motion::FOOTPRINT[dir][2],
+           state.col + motion::FOOTPRINT[dir][3]}};
+}
+
+/*
+ * @brief The rectangle swept by the scanner over a straight run. Footprints
+ * of consecutive poses overlap, so the union of the scans after each of the
+ * forward moves is their bounding box.
+ *
+ * @param state The pose before the run.
+ * @param steps The number of forward moves in the run. Must be at least 1.
+ *
+ * @return The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ */
+constexpr std::array<int, 4> sweptFootprint(const AircraftState &state,
+                                            const int steps) {
+  const std::array<int, 4> first = scanFootprint(advancedBy(state, 1));
+  const std::array<int, 4> last = scanFootprint(advancedBy(state, steps));
+  return {{std::min(first[0], last[0]), std::min(first[1], last[1]),
+           std::max(first[2], last[2]), std::max(first[3], last[3])}};
+}
+
+/*
+ * @brief Measures how many forward moves in a row are legal from a pose.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param state The pose before the run.
+ * @param limit The longest run of interest.
+ *
+ * @return The length of the longest legal straight run, capped at limit.
+ */
+inline int forwardRunLength(const GridMap &map, const AircraftState &state,
+                            const int limit) {
+  const int dir = static_cast<int>(state.dir);
+  return map.openRunLength(state.row, state.col, motion::FORWARD_ROW[dir],
+                           motion::FORWARD_COL[dir], limit);
+}
+
+/*
+ * @brief Counts the Cells a scan from a pose would mark, without marking them.
+ * Uses the map's gain table when it has one.
+ *
+ * @param map The GridMap being scanned.
+ * @param state The pose scanning.
+ *
+ * @return The number of traversable, unscanned Cells in the footprint.
+ */
+inline int footprintGain(const GridMap &map, const AircraftState &state) {
+  // With a gain table the answer is a single lookup
+  if (map.hasGainTable() && map.isWithinBounds(state.row, state.col)) {
+    return map.tableGain(state.row, state.col, static_cast<int>(state.dir));
+  }
+  const std::array<int, 4> area = scanFootprint(state);
+  return map.scanAreaGain(area[0], area[1], area[2], area[3]);
+}
+
+/*
+ * @brief Builds the map's per-(Cell, Direction) gain table for the aircraft's
+ * scanner, so that footprintGain() becomes an O(1) lookup.
+ *
+ * @param map The GridMap being scanned.
+ *
+ * @return Nothing.
+ */
+inline void enableGainTable(GridMap &map) {
+  map.buildGainTable(motion::FOOTPRINT);
+}
+
+/*
+ * @brief Marks the Cells scanned from a pose.
+ *
+ * @param map The GridMap being scanned.
+ * @param state The pose scanning.
+ *
+ * @return The number of Cells newly marked as scanned.
+ */
+inline int scanFromState(GridMap &map, const AircraftState &state) {
+  const std::array<int, 4> area = scanFootprint(state);
+  return map.scanArea(area[0], area[1], area[2], area[3]);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "threadpool.h"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+ThreadPool::ThreadPool(int threadCount) {
+  if (threadCount < 1) {
+    threadCount = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  // The calling thread takes part in every loop, so start one fewer worker
+  for (int i = 1; i < threadCount; i++) {
+    m_workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  for (std::thread &worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &body) {
+  if (count <= 0) {
+    return;
+  }
+
+  // Publish the loop and wake the workers
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_body = &body;
+    m_count = count;
+    m_next = 0;
+    m_error = nullptr;
+    m_busyWorkers = static_cast<int>(m_workers.size());
+    m_generation++;
+  }
+  m_wake.notify_all();
+
+  runIterations();
+
+  // Wait for every worker to leave the loop before the body goes out of scope
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this]() { return m_busyWorkers == 0; });
+  m_body = nullptr;
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+}
+
+void ThreadPool::runIterations() {
+  for (int index = m_next++; index < m_count; index = m_next++) {
+    try {
+      (*m_body)(index);
+    } catch (...) {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_error) {
+        m_error = std::current_exception();
+      }
+      // Skip the iterations nobody has claimed yet
+      m_next = m_count;
+    }
+  }
+}
+
+void ThreadPool::workerLoop() {
+  unsigned long seenGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this, &seenGeneration]() {
+        return m_stopping || m_generation != seenGeneration;
+      });
+      if (m_stopping) {
+        return;
+      }
+      seenGeneration = m_generation;
+    }
+
+    runIterations();
+
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      m_busyWorkers--;
+    }
+    m_done.notify_one();
+  }
+}
@@ -0,0 +1,89 @@
+#ifndef THREADPOOL
+#define THREADPOOL
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * @brief A fixed set of worker threads that run the iterations of a loop in
+ * parallel.
+ *
+ * The threads are started once and reused by every parallelFor() call, so
+ * planners can fan out small batches of work without paying for thread
+ * creation each time.
+ */
+class ThreadPool {
+public:
+  /*
+   * @brief Constructs a ThreadPool.
+   *
+   * @param threadCount The number of threads that run loop iterations,
+   * including the calling thread. Values below 1 select the number of
+   * hardware threads.
+   *
+   * @return Nothing.
+   */
+  explicit ThreadPool(int threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /*
+   * @brief Runs body(0) ... body(count - 1) across the pool and the calling
+   * thread, returning once every iteration has finished.
+   *
+   * @note If an iteration throws, the remaining iterations are skipped and
+   * the first exception is rethrown on the calling thread.
+   *
+   * @param count The number of iterations.
+   * @param body The loop body, called with the iteration index.
+   *
+   * @return Nothing.
+   */
+  void parallelFor(int count, const std::function<void(int)> &body);
+
+  /*
+   * @brief Getter for the number of threads running loop iterations.
+   *
+   * @return The number of worker threads plus the calling thread.
+   */
+  int getThreadCount() const {
+    return static_cast<int>(m_workers.size()) + 1;
+  }
+
+private:
+  /*
+   * @brief Claims and runs iterations of the current loop until none remain.
+   *
+   * @return Nothing.
+   */
+  void runIterations();
+  /*
+   * @brief The loop each worker thread runs until the pool is destroyed.
+   *
+   * @return Nothing.
+   */
+  void workerLoop();
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_wake; // Signals workers that a loop started
+  std::condition_variable m_done; // Signals the caller that a loop finished
+  const std::function<void(int)> *m_body = nullptr; // Current loop body
+  int m_count = 0;                 // Iterations in the current loop
+  std::atomic<int> m_next{0};      // Next unclaimed iteration
+  int m_busyWorkers = 0;           // Workers still inside the current loop
+  unsigned long m_generation = 0;  // Bumped once per parallelFor() call
+  bool m_stopping = false;         // Set by the destructor
+  std::exception_ptr m_error;      // First exception thrown by the body
+};
+
+#endif
@@ -0,0 +1,371 @@
+#include "tour.h"
+#include "map.h"
+#include "state.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Side of the blocks the unscanned Cells are clustered into: the width of a
+// scan, so that one pass through a block can finish it
+constexpr int CLUSTER_BLOCK = 3;
+// Most clusters one tour orders; larger maps are first cut into regions
+constexpr int MAX_TOUR_NODES = 1000;
+// Regions a large map is cut into, about
+constexpr int REGION_COUNT = 256;
+// Distance between Cells that cannot reach each other; small enough that a
+// few can be added up
+constexpr int UNREACHABLE = std::numeric_limits<int>::max() / 8;
+// Most 2-opt passes over a tour
+constexpr int MAX_TWO_OPT_PASSES = 50;
+
+// A block of the map with unscanned Cells in it
+struct Cluster {
+  std::array<int, 4> block; // Inclusive {firstRow, firstCol, lastRow, lastCol}
+  int row;                  // Row of the unscanned Cell closest to its centre
+  int col;                  // Column of that Cell
+};
+
+/*
+ * @brief Helper function for planCoverageTour(). Cuts a rectangle of the map
+ * into square blocks and keeps those with an unscanned traversable Cell.
+ *
+ * @param map The GridMap being clustered.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * @param blockSize The side of the blocks.
+ *
+ * @return The clusters, in row-major order.
+ */
+std::vector<Cluster> findClusters(const GridMap &map,
+                                  const std::array<int, 4> &area,
+                                  const int blockSize) {
+  std::vector<Cluster> clusters;
+  for (int firstRow = area[0]; firstRow <= area[2]; firstRow += blockSize) {
+    for (int firstCol = area[1]; firstCol <= area[3]; firstCol += blockSize) {
+      Cluster cluster = {{firstRow, firstCol,
+                          std::min(firstRow + blockSize - 1, area[2]),
+                          std::min(firstCol + blockSize - 1, area[3])},
+                         -1,
+                         -1};
+      const int middleRow = (cluster.block[0] + cluster.block[2]) / 2;
+      const int middleCol = (cluster.block[1] + cluster.block[3]) / 2;
+      int bestDistance = 0;
+      for (int row = cluster.block[0]; row <= cluster.block[2]; row++) {
+        for (int col = cluster.block[1]; col <= cluster.block[3]; col++) {
+          const int distance =
+              std::abs(row - middleRow) + std::abs(col - middleCol);
+          if (map.canOccupy(row, col) && !map.isScanned(row, col) &&
+              (cluster.row < 0 || distance < bestDistance)) {
+            cluster.row = row;
+            cluster.col = col;
+            bestDistance = distance;
+          }
+        }
+      }
+      if (cluster.row >= 0) {
+        clusters.push_back(cluster);
+      }
+    }
+  }
+  return clusters;
+}
+
+/*
+ * @brief Helper function for planCoverageTour(). Measures the distance from
+ * one Cell to every Cell of a rectangle, moving between traversable
+ * neighbours without leaving it.
+ *
+ * @param map The GridMap being measured.
+ * @param area The inclusive {firstRow, firstCol, lastRow, lastCol} rectangle.
+ * @param row The row to measure from. Must be inside the area.
+ * @param col The column to measure from.
+ *
+ * @return The distance to each Cell of the area, row-major within it;
+ * UNREACHABLE for Cells that cannot be reached.
+ */
+std::vector<int> cellDistances(const GridMap &map,
+                               const std::array<int, 4> &area, const int row,
+                               const int col) {
+  const int width = area[3] - area[1] + 1;
+  std::vector<int> distances(
+      static_cast<std::size_t>(area[2] - area[0] + 1) * width, UNREACHABLE);
+  std::vector<int> queue = {(row - area[0]) * width + (col - area[1])};
+  distances[queue.front()] = 0;
+  for (std::size_t head = 0; head < queue.size(); head++) {
+    const int cell = queue[head];
+    for (int dir = 0; dir < 4; dir++) {
+      const int nextRow = area[0] + cell / width + motion::FORWARD_ROW[dir];
+      const int nextCol = area[1] + cell % width + motion::FORWARD_COL[dir];
+      if (nextRow < area[0] || nextRow > area[2] || nextCol < area[1] ||
+          nextCol > area[3] || !map.canOccupy(nextRow, nextCol)) {
+        continue;
+      }
+      const int next = (nextRow - area[0]) * width + (nextCol - area[1]);
+      if (distances[next] == UNREACHABLE) {
+        distances[next] = distances[cell] + 1;
+        queue.push_back(next);
+      }
+    }
+  }
+  return distances;
+}
+
+/*
+ * @brief Helper function for planCoverageTour(). Measures the distance
+ * between every pair of clusters inside a rectangle, one search per cluster.
+ *
+ * @param map The GridMap being measured.
+ * @param area The inclusive rectangle the paths stay in.
+ * @param clusters The clusters. Their Cells must be inside the area.
+ * @param pool Runs the searches; nullptr to run them on this thread.
+ *
+ * @return The distance matrix, row-major.
+ */
+std::vector<int> clusterDistances(const GridMap &map,
+                                  const std::array<int, 4> &area,
+                                  const std::vector<Cluster> &clusters,
+                                  ThreadPool *pool) {
+  const int count = static_cast<int>(clusters.size());
+  const int width = area[3] - area[1] + 1;
+  std::vector<int> distances(static_cast<std::size_t>(count) * count);
+  const auto measure = [&](const int from) {
+    const std::vector<int> fromCluster =
+        cellDistances(map, area, clusters[from].row, clusters[from].col);
+    for (int to = 0; to < count; to++) {
+      distances[from * count + to] =
+          fromCluster[(clusters[to].row - area[0]) * width +
+                      (clusters[to].col - area[1])];
+    }
+  };
+  if (pool != nullptr) {
+    pool->parallelFor(count, measure);
+  } else {
+    for (int from = 0; from < count; from++) {
+      measure(from);
+    }
+  }
+  return distances;
+}
+
+/*
+ * @brief Helper function for planCoverageTour(). Builds an open tour from
+ * node 0 by nearest insertion: the node closest to the tour joins it where
+ * it lengthens the tour least.
+ *
+ * @param distances The distance between each pair of nodes, row-major.
+ * @param nodeCount The number of nodes.
+ *
+ * @return The nodes in visiting order, starting with 0. Nodes that cannot be
+ * reached are left out.
+ */
+std::vector<int> nearestInsertion(const std::vector<int> &distances,
+                                  const int nodeCount) {
+  const auto distance = [&](const int a, const int b) {
+    return distances[a * nodeCount + b];
+  };
+  std::vector<int> tour = {0};
+  std::vector<bool> inTour(nodeCount, false);
+  inTour[0] = true;
+  std::vector<int> nearest(distances.begin(), distances.begin() + nodeCount);
+  while (static_cast<int>(tour.size()) < nodeCount) {
+    int node = -1;
+    for (int other = 0; other < nodeCount; other++) {
+      if (!inTour[other] && (node < 0 || nearest[other] < nearest[node])) {
+        node = other;
+      }
+    }
+    if (nearest[node] >= UNREACHABLE) {
+      break;
+    }
+    // Appending only adds the last leg; inserting replaces one leg with two
+    std::size_t bestPosition = tour.size();
+    int bestCost = distance(tour.back(), node);
+    for (std::size_t index = 0; index + 1 < tour.size(); index++) {
+      const int cost = distance(tour[index], node) +
+                       distance(node, tour[index + 1]) -
+                       distance(tour[index], tour[index + 1]);
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestPosition = index + 1;
+      }
+    }
+    tour.insert(tour.begin() + bestPosition, node);
+    inTour[node] = true;
+    for (int other = 0; other < nodeCount; other++) {
+      nearest[other] = std::min(nearest[other], distance(node, other));
+    }
+  }
+  return tour;
+}
+
+/*
+ * @brief Helper function for planCoverageTour(). Shortens an open tour by
+ * reversing stretches of it while that helps. The first node stays first.
+ *
+ * @param distances The distance between each pair of nodes, row-major.
+ * @param nodeCount The number of nodes.
+ * @param tour The tour. Updated in place.
+ *
+ * @return Nothing.
+ */
+void twoOpt(const std::vector<int> &distances, const int nodeCount,
+            std::vector<int> &tour) {
+  const auto distance = [&](const int a, const int b) {
+    return distances[a * nodeCount + b];
+  };
+  const int size = static_cast<int>(tour.size());
+  bool improved = true;
+  for (int pass = 0; improved && pass < MAX_TWO_OPT_PASSES; pass++) {
+    improved = false;
+    for (int first = 1; first + 1 < size; first++) {
+      for (int last = first + 1; last < size; last++) {
+        // Reversing tour[first..last] swaps the legs at either end
+        int change = distance(tour[first - 1], tour[last]) -
+                     distance(tour[first - 1], tour[first]);
+        if (last + 1 < size) {
+          change += distance(tour[first], tour[last + 1]) -
+                    distance(tour[last], tour[last + 1]);
+        }
+        if (change < 0) {
+          std::reverse(tour.begin() + first, tour.begin() + last + 1);
+          improved = true;
+        }
+      }
+    }
+  }
+}
+
+/*
+ * @brief Helper function for planCoverageTour(). Orders clusters into a short
+ * open tour from a Cell.
+ *
+ * @param distances The distances between the clusters, row-major.
+ * @param startDistances The distance from the start to each cluster.
+ *
+ * @return The indices of the clusters in visiting order. Clusters the start
+ * cannot reach are left out.
+ */
+std::vector<int> orderClusters(const std::vector<int> &distances,
+                               const std::vector<int> &startDistances) {
+  // Node 0 is the start and node i + 1 is cluster i
+  const int count = static_cast<int>(startDistances.size());
+  const int nodeCount = count + 1;
+  std::vector<int> nodeDistances(static_cast<std::size_t>(nodeCount) *
+                                     nodeCount,
+                                 0);
+  for (int from = 0; from < count; from++) {
+    nodeDistances[from + 1] = startDistances[from];
+    nodeDistances[(from + 1) * nodeCount] = startDistances[from];
+    for (int to = 0; to < count; to++) {
+      nodeDistances[(from + 1) * nodeCount + to + 1] =
+          distances[from * count + to];
+    }
+  }
+  std::vector<int> tour = nearestInsertion(nodeDistances, nodeCount);
+  twoOpt(nodeDistances, nodeCount, tour);
+  std::vector<int> order;
+  for (std::size_t index = 1; index < tour.size(); index++) {
+    order.push_back(tour[index] - 1);
+  }
+  return order;
+}
+
+} // namespace
+
+CoverageTour planCoverageTour(const GridMap &map, const int startRow,
+                              const int startCol, const int threadCount) {
+  CoverageTour result;
+  const std::array<int, 4> whole = {0, 0, map.getRowCount() - 1,
+                                    map.getColCount() - 1};
+  const int cols = map.getColCount();
+  ThreadPool pool(threadCount);
+
+  const std::vector<Cluster> clusters =
+      findClusters(map, whole, CLUSTER_BLOCK);
+  if (static_cast<int>(clusters.size()) <= MAX_TOUR_NODES) {
+    // Small enough to order every cluster at once
+    const std::vector<int> distances =
+        clusterDistances(map, whole, clusters, &pool);
+    const std::vector<int> fromStart =
+        cellDistances(map, whole, startRow, startCol);
+    std::vector<int> startDistances;
+    for (const Cluster &cluster : clusters) {
+      startDistances.push_back(fromStart[cluster.row * cols + cluster.col]);
+    }
+    int previous = -1;
+    for (const int index : orderClusters(distances, startDistances)) {
+      result.clusters.push_back(clusters[index].block);
+      result.length += previous < 0
+                           ? startDistances[index]
+                           : distances[previous * clusters.size() + index];
+      previous = index;
+    }
+    return result;
+  }
+
+  // Order regions of the map first, then the clusters inside each region.
+  // Regions are whole numbers of blocks so that their blocks line up.
+  const int regionBlocks = static_cast<int>(std::ceil(
+      std::sqrt(static_cast<double>(clusters.size()) / REGION_COUNT)));
+  const int regionSize = regionBlocks * CLUSTER_BLOCK;
+  const std::vector<Cluster> regions = findClusters(map, whole, regionSize);
+  const std::vector<int> regionDistances =
+      clusterDistances(map, whole, regions, &pool);
+  const std::vector<int> fromStart =
+      cellDistances(map, whole, startRow, startCol);
+  std::vector<int> regionStart;
+  for (const Cluster &region : regions) {
+    regionStart.push_back(fromStart[region.row * cols + region.col]);
+  }
+  const std::vector<int> regionOrder =
+      orderClusters(regionDistances, regionStart);
+
+  // Each region's clusters and distances, measured inside the region
+  std::vector<std::vector<Cluster>> regionClusters(regions.size());
+  std::vector<std::vector<int>> insideDistances(regions.size());
+  pool.parallelFor(static_cast<int>(regions.size()), [&](const int region) {
+    regionClusters[region] =
+        findClusters(map, regions[region].block, CLUSTER_BLOCK);
+    insideDistances[region] = clusterDistances(
+        map, regions[region].block, regionClusters[region], nullptr);
+  });
+
+  // Enter each region at the cluster that continues the tour best; the leg
+  // in is estimated by Manhattan distance, and so is any leg between two
+  // clusters that are only connected outside their region
+  int row = startRow;
+  int col = startCol;
+  for (const int region : regionOrder) {
+    const std::vector<Cluster> &inside = regionClusters[region];
+    std::vector<int> entryDistances;
+    for (const Cluster &cluster : inside) {
+      entryDistances.push_back(std::abs(cluster.row - row) +
+                               std::abs(cluster.col - col));
+    }
+    int previous = -1;
+    for (const int index :
+         orderClusters(insideDistances[region], entryDistances)) {
+      result.clusters.push_back(inside[index].block);
+      if (previous < 0) {
+        result.length += entryDistances[index];
+      } else {
+        const int leg =
+            insideDistances[region][previous * inside.size() + index];
+        result.length += leg < UNREACHABLE
+                             ? leg
+                             : std::abs(inside[index].row - row) +
+                                   std::abs(inside[index].col - col);
+      }
+      previous = index;
+      row = inside[index].row;
+      col = inside[index].col;
+    }
+  }
+  return result;
+}
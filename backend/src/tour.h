@@ -0,0 +1,46 @@
+#ifndef TOUR
+#define TOUR
+
+#include "map.h"
+#include <array>
+#include <vector>
+
+/*
+ * @brief An order in which to visit the unscanned parts of a map.
+ */
+struct CoverageTour {
+  // Inclusive {firstRow, firstCol, lastRow, lastCol} blocks, in visiting order
+  std::vector<std::array<int, 4>> clusters;
+  int length = 0; // Cells travelled from the start through every cluster
+};
+
+/*
+ * @brief Groups the unscanned traversable Cells of a map into clusters and
+ * orders them into a short tour.
+ *
+ * The map is cut into blocks as wide as a scan, and every block holding an
+ * unscanned traversable Cell is a cluster, represented by its unscanned Cell
+ * closest to the block's centre. The travel distances between clusters,
+ * along traversable Cells, are measured by one breadth-first search per
+ * cluster on a ThreadPool. An open tour from the start through every
+ * reachable cluster is built by nearest insertion and then shortened by
+ * 2-opt.
+ *
+ * Maps with too many clusters for one distance matrix are first cut into a
+ * few hundred square regions, which are ordered the same way. The clusters
+ * of each region are then ordered inside it, starting from the cluster
+ * closest to where the previous region's tour ended. Legs into a region are
+ * estimated by Manhattan distance.
+ *
+ * @param map The GridMap to cover. It is not modified.
+ * @param startRow The row the tour starts from. Must be traversable.
+ * @param startCol The column the tour starts from.
+ * @param threadCount The number of threads measuring distances; values below
+ * 1 use every hardware thread.
+ *
+ * @return The clusters in visiting order and the length of the tour.
+ */
+CoverageTour planCoverageTour(const GridMap &map, int startRow, int startCol,
+                              int threadCount = 0);
+
+#endif
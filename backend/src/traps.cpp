@@ -0,0 +1,89 @@
+#include "traps.h"
+#include "bitgrid.h"
+#include "map.h"
+#include "search.h"
+#include "state.h"
+#include "workspace.h"
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/*
+ * @brief Helper function for the TrapTable constructor. Works out which
+ * flying moves are legal from a pose.
+ *
+ * @param map The GridMap the aircraft exists on.
+ * @param state The pose.
+ *
+ * @return The SuccessorBit mask.
+ */
+std::uint8_t successorMask(const GridMap &map, const AircraftState &state) {
+  std::uint8_t mask = 0;
+  const std::array<std::pair<Direction, SuccessorBit>, 3> headings = {{
+      {state.dir, succ_FORWARD},
+      {turnedLeft(state.dir), succ_TURNLEFT},
+      {turnedRight(state.dir), succ_TURNRIGHT},
+  }};
+  for (const auto &heading : headings) {
+    const AircraftState ahead =
+        advancedBy(makeState(state.row, state.col, heading.first), 1);
+    if (map.canOccupy(ahead.row, ahead.col)) {
+      mask |= heading.second;
+    }
+  }
+  return mask;
+}
+
+} // namespace
+
+TrapTable::TrapTable(const GridMap &map) : m_colCount(map.getColCount()) {
+  const int poseCount = stateCount(map);
+  m_masks.assign(poseCount, 0);
+  m_escapable.assign(poseCount, 0);
+  std::vector<int> remaining(poseCount, 0); // Successors not yet removed
+
+  // Removed poses go through the workspace's FIFO frontier
+  SearchWorkspace workspace;
+  workspace.begin(poseCount);
+  for (int id = 0; id < poseCount; id++) {
+    const AircraftState state = stateFromId(map, id);
+    if (!map.canOccupy(state.row, state.col)) {
+      continue;
+    }
+    m_masks[id] = successorMask(map, state);
+    m_escapable[id] = 1;
+    remaining[id] = popcount64(m_masks[id]);
+    if (remaining[id] == 0) {
+      workspace.push(id);
+    }
+  }
+
+  while (!workspace.frontierEmpty()) {
+    const int id = workspace.pop();
+    m_escapable[id] = 0;
+    m_trappedCount++;
+
+    // The poses one flying move before this one: straight behind it, or
+    // behind it facing sideways and turning into its heading
+    const AircraftState state = stateFromId(map, id);
+    const AircraftState behind = advancedBy(state, -1);
+    if (!map.canOccupy(behind.row, behind.col)) {
+      continue;
+    }
+    const std::array<std::pair<Direction, SuccessorBit>, 3> previous = {{
+        {state.dir, succ_FORWARD},
+        {turnedRight(state.dir), succ_TURNLEFT},
+        {turnedLeft(state.dir), succ_TURNRIGHT},
+    }};
+    for (const auto &entry : previous) {
+      const int prevId =
+          stateId(map, makeState(behind.row, behind.col, entry.first));
+      if ((m_masks[prevId] & entry.second) != 0 && --remaining[prevId] == 0) {
+        workspace.push(prevId);
+      }
+    }
+  }
+}
@@ -0,0 +1,103 @@
+#ifndef TRAPS
+#define TRAPS
+
+#include "map.h"
+#include "state.h"
+#include <cstdint>
+#include <vector>
+
+// Bits of a TrapTable successor mask: the flying moves legal from a pose
+enum SuccessorBit : std::uint8_t {
+  succ_FORWARD = 1,   // Move forward
+  succ_TURNLEFT = 2,  // Turn left, then move forward
+  succ_TURNRIGHT = 4  // Turn right, then move forward
+};
+
+/*
+ * @brief Precomputed mobility of every aircraft pose on a GridMap.
+ *
+ * For each (Cell, Direction) the table keeps a 3-bit mask of the moves that
+ * keep the aircraft flying: straight ahead, or a turn followed by a forward
+ * move. A pose is escapable if some sequence of those moves can go on
+ * forever. The rest are box canyons: however the aircraft flies on from
+ * them, it reaches a pose where it must turn around on the spot.
+ *
+ * Escapability is found in one reverse pass. Poses with an empty mask are
+ * removed first; removing a pose takes one successor away from each of its
+ * predecessors, and a predecessor left with none is removed in turn.
+ *
+ * The table is a snapshot of the map's terrain. Rebuild it after Cells are
+ * marked untraversable.
+ */
+class TrapTable {
+public:
+  /*
+   * @brief Builds the masks and escapable flags for every pose.
+   *
+   * @param map The GridMap the aircraft exists on.
+   *
+   * @return Nothing.
+   */
+  explicit TrapTable(const GridMap &map);
+
+  /*
+   * @brief Getter for the successor mask of a pose.
+   *
+   * @param state The pose. Must be on the map.
+   *
+   * @return A combination of SuccessorBit values; 0 for poses on
+   * untraversable Cells.
+   */
+  std::uint8_t getSuccessors(const AircraftState &state) const {
+    return m_masks[poseIndex(state)];
+  }
+
+  /*
+   * @brief Determines if a flying move is legal from a pose.
+   *
+   * @param state The pose. Must be on the map.
+   * @param successor The move being checked.
+   *
+   * @return True if the move keeps the aircraft on traversable Cells, else
+   * false.
+   */
+  bool hasSuccessor(const AircraftState &state,
+                    const SuccessorBit successor) const {
+    return (getSuccessors(state) & successor) != 0;
+  }
+
+  /*
+   * @brief Determines if the aircraft can fly on from a pose indefinitely
+   * without turning around on the spot.
+   *
+   * @param state The pose. Must be on the map.
+   *
+   * @return True if the pose is escapable, else false. Always false on
+   * untraversable Cells.
+   */
+  bool isEscapable(const AircraftState &state) const {
+    return m_escapable[poseIndex(state)] != 0;
+  }
+
+  /*
+   * @brief Getter for the number of poses on traversable Cells that are not
+   * escapable.
+   *
+   * @return The number of box canyon poses.
+   */
+  int getTrappedCount() const { return m_trappedCount; }
+
+private:
+  // Dense index of a pose, matching stateId()
+  int poseIndex(const AircraftState &state) const {
+    return (state.row * m_colCount + state.col) * 4 +
+           static_cast<int>(state.dir);
+  }
+
+  int m_colCount = 0;                   // Columns of the map
+  int m_trappedCount = 0;               // Traversable poses not escapable
+  std::vector<std::uint8_t> m_masks;    // SuccessorBit mask of each pose
+  std::vector<std::uint8_t> m_escapable; // 1 if the pose is escapable
+};
+
+#endif
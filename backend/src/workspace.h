@@ -0,0 +1,187 @@
+#ifndef WORKSPACE
+#define WORKSPACE
+
+#include "cancel.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/*
+ * @brief Reusable buffers for breadth-first searches over densely numbered
+ * nodes (Cells or aircraft poses).
+ *
+ * The buffers grow to the largest search seen and are then reused. Instead of
+ * clearing the visited set, begin() bumps a generation counter: a node counts
+ * as visited only if its stamp equals the current generation, so starting a
+ * search is O(1). A workspace is not thread-safe; give each thread its own.
+ *
+ * The workspace also carries the CancelToken of the planner that owns it, so
+ * long searches can give up part way through.
+ */
+class SearchWorkspace {
+public:
+  /*
+   * @brief Starts a new search, forgetting every visited node.
+   *
+   * @param nodeCount The number of nodes the search may touch.
+   *
+   * @return Nothing.
+   */
+  void begin(const int nodeCount) {
+    if (static_cast<int>(m_stamps.size()) < nodeCount) {
+      m_stamps.resize(nodeCount, 0);
+      m_parents.resize(nodeCount, 0);
+      m_costs.resize(nodeCount, 0);
+      m_frontier.resize(nodeCount);
+    }
+    m_head = 0;
+    m_tail = 0;
+    // Stamps only need clearing when the generation counter wraps around
+    if (m_generation == std::numeric_limits<std::uint32_t>::max()) {
+      std::fill(m_stamps.begin(), m_stamps.end(), 0);
+      m_generation = 0;
+    }
+    m_generation++;
+  }
+
+  /*
+   * @brief Determines if a node has been visited in the current search.
+   *
+   * @param node The node.
+   *
+   * @return True if the node has been visited, else false.
+   */
+  bool isVisited(const int node) const {
+    return m_stamps[node] == m_generation;
+  }
+
+  /*
+   * @brief Marks a node visited and appends it to the FIFO frontier. Each node
+   * may be pushed at most once per search.
+   *
+   * @param node The node.
+   * @param parent A byte of bookkeeping kept for the node, such as the move
+   * that reached it.
+   *
+   * @return Nothing.
+   */
+  void push(const int node, const std::uint8_t parent = 0) {
+    visit(node, parent);
+    m_frontier[m_tail++] = node;
+  }
+
+  /*
+   * @brief Marks a node visited without adding it to the frontier.
+   *
+   * @param node The node.
+   * @param parent A byte of bookkeeping kept for the node.
+   *
+   * @return Nothing.
+   */
+  void visit(const int node, const std::uint8_t parent = 0) {
+    m_stamps[node] = m_generation;
+    m_parents[node] = parent;
+  }
+
+  /*
+   * @brief Determines if the frontier has been exhausted.
+   *
+   * @return True if no pushed node remains to be popped, else false.
+   */
+  bool frontierEmpty() const { return m_head == m_tail; }
+
+  /*
+   * @brief Removes the oldest node from the frontier. Requires
+   * !frontierEmpty().
+   *
+   * @return The node.
+   */
+  int pop() { return m_frontier[m_head++]; }
+
+  /*
+   * @brief Getter for the byte recorded when a node was visited.
+   *
+   * @param node A node visited in the current search.
+   *
+   * @return The byte passed to push() or visit().
+   */
+  std::uint8_t getParent(const int node) const { return m_parents[node]; }
+
+  /*
+   * @brief Records the best known cost of reaching a node, for searches that
+   * may improve on the first path found (A*).
+   *
+   * @param node A node visited in the current search.
+   * @param cost The cost.
+   *
+   * @return Nothing.
+   */
+  void setCost(const int node, const int cost) { m_costs[node] = cost; }
+
+  /*
+   * @brief Getter for the cost recorded with setCost().
+   *
+   * @param node A node visited in the current search.
+   *
+   * @return The cost.
+   */
+  int getCost(const int node) const { return m_costs[node]; }
+
+  /*
+   * @brief Storage for a bucket queue: bucket i holds the nodes with integer
+   * priority i. Searches must leave every bucket empty when they finish.
+   *
+   * @return The buckets.
+   */
+  std::vector<std::vector<int>> &getBuckets() { return m_buckets; }
+
+  /*
+   * @brief Getter for the number of nodes pushed in the current search.
+   *
+   * @return The number of nodes pushed since begin().
+   */
+  int getPushedCount() const { return m_tail; }
+
+  /*
+   * @brief Sets the CancelToken searches poll.
+   *
+   * @param token The token.
+   *
+   * @return Nothing.
+   */
+  void setCancelToken(const CancelToken &token) { m_token = token; }
+  /*
+   * @brief Polls the CancelToken from a search loop. The clock is only read
+   * on every POLL_INTERVAL-th call, so polling every step stays cheap.
+   *
+   * @return True if the search should give up, else false.
+   */
+  bool pollStop() {
+    return ++m_polls % POLL_INTERVAL == 0 && m_token.stopRequested();
+  }
+  /*
+   * @brief Reads the CancelToken at once, such as after a search to tell if
+   * it gave up.
+   *
+   * @return True if searches should give up, else false.
+   */
+  bool stopRequested() const { return m_token.stopRequested(); }
+
+private:
+  std::vector<std::uint32_t> m_stamps; // Generation each node was visited in
+  std::vector<std::uint8_t> m_parents; // Per-node bookkeeping byte
+  std::vector<int> m_costs;            // Per-node best cost, if used
+  std::vector<int> m_frontier;         // FIFO; a node enters at most once
+  int m_head = 0;                      // Next node to pop
+  int m_tail = 0;                      // Next free frontier slot
+  std::uint32_t m_generation = 0;      // Current search
+
+  std::vector<std::vector<int>> m_buckets; // Bucket queue for A*
+
+  static constexpr unsigned POLL_INTERVAL = 4096; // Steps between token reads
+  CancelToken m_token;                            // Stops long searches
+  unsigned m_polls = 0;                           // pollStop() calls so far
+};
+
+#endif
@@ -169,3 +169,81 @@ TEST(AircraftTest, TraversabilityTest) {
   EXPECT_TRUE(
       gridMap.isTraversable(aircraft2.getCurRow(), aircraft2.getCurCol()));
 }
+
+TEST(AircraftTest, ScanGainTest) {
+  GridMap gridMap(6, "test_csv/scanTestCSV.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, gridMap);
+
+  // scanGain() reports the same count as scan() without marking any Cells
+  EXPECT_EQ(aircraft.scanGain(), 4);
+  EXPECT_FALSE(aircraft.getMap().isScanned(0, 1));
+  EXPECT_EQ(aircraft.scanGain(1, 2, Direction::dir_SOUTH), 6);
+
+  EXPECT_EQ(aircraft.scan(), 4);
+  EXPECT_EQ(aircraft.scanGain(), 0);
+  EXPECT_EQ(aircraft.scan(), 0);
+
+  // Overlapping footprints only count Cells that are still unscanned
+  EXPECT_EQ(aircraft.scanGain(1, 2, Direction::dir_SOUTH), 6);
+  EXPECT_EQ(aircraft.scanGain(0, 1, Direction::dir_EAST), 2);
+}
+
+TEST(AircraftTest, StateStepTest) {
+  GridMap gridMap(4, "test_csv/manuverableCSV.csv");
+  AircraftState next{};
+
+  // Turning in place is always legal
+  const AircraftState start = makeState(0, 0, Direction::dir_NORTH);
+  ASSERT_TRUE(step(start, Moves::move_TURNRIGHT, gridMap, next));
+  EXPECT_EQ(next, makeState(0, 0, Direction::dir_EAST));
+  ASSERT_TRUE(step(start, Moves::move_TURNLEFT, gridMap, next));
+  EXPECT_EQ(next, makeState(0, 0, Direction::dir_WEST));
+
+  // Leaving the map or landing on an untraversable Cell fails without throwing
+  EXPECT_FALSE(step(start, Moves::move_FORWARD, gridMap, next));
+  EXPECT_FALSE(step(makeState(1, 1, Direction::dir_EAST), Moves::move_FORWARD,
+                    gridMap, next));
+
+  ASSERT_TRUE(step(makeState(1, 1, Direction::dir_WEST), Moves::move_FORWARD,
+                   gridMap, next));
+  EXPECT_EQ(next, makeState(1, 0, Direction::dir_WEST));
+
+  // Aircraft shares the same transitions
+  Aircraft aircraft(1, Direction::dir_WEST, 1, gridMap);
+  aircraft.moveForward();
+  EXPECT_EQ(aircraft.getState(), next);
+}
+
+TEST(AircraftTest, ForwardRunTest) {
+  GridMap gridMap(100, "test_csv/bigTestGrid.csv");
+  const Direction dirs[] = {Direction::dir_NORTH, Direction::dir_SOUTH,
+                            Direction::dir_EAST, Direction::dir_WEST};
+
+  // forward(k) must match k single moves followed by scans, from every pose
+  for (int row = 0; row < gridMap.getRowCount(); row += 7) {
+    for (int col = 0; col < gridMap.getColCount(); col += 3) {
+      if (!gridMap.isTraversable(row, col)) {
+        continue;
+      }
+      for (const Direction dir : dirs) {
+        Aircraft stepped(row, dir, col, gridMap);
+        Aircraft swept(row, dir, col, gridMap);
+
+        int run = 0;
+        int steppedGain = 0;
+        AircraftState next{};
+        while (step(stepped.getState(), Moves::move_FORWARD, gridMap, next)) {
+          stepped.moveForward();
+          steppedGain += stepped.scan();
+          run++;
+        }
+        ASSERT_EQ(swept.forwardRunLength(1000), run);
+        EXPECT_EQ(swept.forwardRunLength(2), std::min(run, 2));
+
+        EXPECT_EQ(swept.forward(run), steppedGain);
+        EXPECT_EQ(swept.getState(), stepped.getState());
+        EXPECT_THROW(swept.forward(1), std::exception);
+      }
+    }
+  }
+}
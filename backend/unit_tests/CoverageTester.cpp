@@ -0,0 +1,270 @@
+#include "../src/beamsearch.h"
+#include "../src/boustrophedon.h"
+#include "../src/orienteering.h"
+#include "../src/partition.h"
+#include "../src/replay.h"
+#include "../src/router1.h"
+#include "../src/spanningtree.h"
+#include "../src/tour.h"
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+TEST(CoverageTest, DecompositionTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  const std::vector<SweepCell> cells = decomposeBoustrophedon(map);
+  ASSERT_FALSE(cells.empty());
+
+  // Every traversable Cell lies in exactly one cell, and cells hold nothing
+  // else
+  std::vector<int> owners(map.getRowCount() * map.getColCount(), 0);
+  for (int index = 0; index < static_cast<int>(cells.size()); index++) {
+    const SweepCell &cell = cells[index];
+    for (int col = cell.firstCol; col <= cell.lastCol(); col++) {
+      const int top = cell.topRows[col - cell.firstCol];
+      const int bottom = cell.bottomRows[col - cell.firstCol];
+      for (int row = top; row <= bottom; row++) {
+        ASSERT_TRUE(map.canOccupy(row, col));
+        owners[row * map.getColCount() + col]++;
+      }
+      // Consecutive intervals share a row
+      if (col > cell.firstCol) {
+        EXPECT_LE(cell.topRows[col - cell.firstCol - 1], bottom);
+        EXPECT_LE(top, cell.bottomRows[col - cell.firstCol - 1]);
+      }
+    }
+    for (const int neighbour : cell.neighbours) {
+      const std::vector<int> &back = cells[neighbour].neighbours;
+      EXPECT_NE(std::find(back.begin(), back.end(), index), back.end());
+    }
+  }
+  for (int row = 0; row < map.getRowCount(); row++) {
+    for (int col = 0; col < map.getColCount(); col++) {
+      EXPECT_EQ(owners[row * map.getColCount() + col],
+                map.canOccupy(row, col) ? 1 : 0);
+    }
+  }
+}
+
+TEST(CoverageTest, BoustrophedonRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  BoustrophedonPlanner planner(aircraft, 0.8, 10000);
+  EXPECT_GT(planner.getCellCount(), 1);
+
+  const std::vector<Moves> route = planner.findRoute();
+  const ReplayResult replay = replayRoute(map, aircraft.getState(), route);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_GE(replay.coverage, 0.8);
+  EXPECT_LE(route.size(), 10000u);
+}
+
+TEST(CoverageTest, BoustrophedonMoveLimitTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  BoustrophedonPlanner planner(aircraft, 1.0, 150);
+
+  const std::vector<Moves> route = planner.findRoute();
+  EXPECT_EQ(route.size(), 150u);
+  EXPECT_TRUE(replayRoute(map, aircraft.getState(), route).valid);
+}
+
+TEST(CoverageTest, SpanningForestTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const SpanningForest forest = buildSpanningForest(map);
+  ASSERT_GT(forest.treeCount, 0);
+
+  // Each tree of n blocks has n - 1 edges, and edges join usable blocks of
+  // the same tree from both ends
+  std::vector<int> blocks(forest.treeCount, 0);
+  std::vector<int> edges(forest.treeCount, 0);
+  for (int block = 0; block < forest.blockRows * forest.blockCols; block++) {
+    const int tree = forest.trees[block];
+    if (tree < 0) {
+      EXPECT_EQ(forest.edges[block], 0);
+      continue;
+    }
+    blocks[tree]++;
+    if (forest.hasEdge(block, Direction::dir_EAST)) {
+      edges[tree]++;
+      EXPECT_EQ(forest.trees[block + 1], tree);
+      EXPECT_TRUE(forest.hasEdge(block + 1, Direction::dir_WEST));
+    }
+    if (forest.hasEdge(block, Direction::dir_SOUTH)) {
+      edges[tree]++;
+      EXPECT_EQ(forest.trees[block + forest.blockCols], tree);
+      EXPECT_TRUE(
+          forest.hasEdge(block + forest.blockCols, Direction::dir_NORTH));
+    }
+  }
+  for (int tree = 0; tree < forest.treeCount; tree++) {
+    EXPECT_EQ(edges[tree], blocks[tree] - 1);
+  }
+}
+
+TEST(CoverageTest, SpanningTreeRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  SpanningTreePlanner planner(aircraft, 0.8, 10000);
+  EXPECT_GT(planner.getBlockCount(), 0);
+
+  const std::vector<Moves> route = planner.findRoute();
+  const ReplayResult replay = replayRoute(map, aircraft.getState(), route);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_GE(replay.coverage, 0.8);
+  EXPECT_LE(route.size(), 10000u);
+
+  // The move limit is respected
+  GridMap medium(50, "test_csv/mediumTestGrid.csv");
+  Aircraft small(0, Direction::dir_EAST, 0, medium);
+  SpanningTreePlanner limited(small, 1.0, 150);
+  const std::vector<Moves> limitedRoute = limited.findRoute();
+  EXPECT_EQ(limitedRoute.size(), 150u);
+  EXPECT_TRUE(replayRoute(medium, small.getState(), limitedRoute).valid);
+}
+
+TEST(CoverageTest, BeamRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  BeamPlanner planner(aircraft, 0.8, 10000);
+  const std::vector<Moves> route = planner.findRoute();
+  const ReplayResult replay = replayRoute(map, aircraft.getState(), route);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_GE(replay.coverage, 0.8);
+
+  // Looking ahead beats the one-move greedy rule
+  RoutePlanner greedy(aircraft, 0.8, 10000);
+  EXPECT_LT(route.size(), greedy.findRoute().size());
+
+  // Splitting the levels across threads does not change the route
+  BeamPlanner parallel(aircraft, 0.8, 10000, 16, 6, 4);
+  EXPECT_EQ(parallel.findRoute(), route);
+
+  // Bounds checking
+  BeamPlanner clamped(aircraft, 0.8, 10000, 0, -2);
+  EXPECT_EQ(clamped.getBeamWidth(), 1);
+  EXPECT_EQ(clamped.getHorizon(), 1);
+}
+
+TEST(CoverageTest, OrienteeringRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  OrienteeringPlanner planner(aircraft, 1.0, 1000);
+  const std::vector<Moves> route = planner.findRoute();
+  const ReplayResult replay = replayRoute(map, aircraft.getState(), route);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_LE(route.size(), 1000u);
+
+  // When the budget binds, it scans more than the greedy rule does
+  RoutePlanner greedy(aircraft, 1.0, 1000);
+  const ReplayResult greedyReplay =
+      replayRoute(map, aircraft.getState(), greedy.findRoute());
+  EXPECT_GT(replay.scannedCount, greedyReplay.scannedCount);
+
+  // With budget to spare it still reaches the coverage target
+  OrienteeringPlanner ample(aircraft, 0.8, 10000);
+  EXPECT_GE(replayRoute(map, aircraft.getState(), ample.findRoute()).coverage,
+            0.8);
+}
+
+TEST(CoverageTest, CoverageTourTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const CoverageTour tour = planCoverageTour(map, 0, 0, 2);
+  EXPECT_GT(tour.length, 0);
+
+  // Every unscanned Cell lies in exactly one cluster, visited once
+  std::set<std::array<int, 4>> visited(tour.clusters.begin(),
+                                       tour.clusters.end());
+  EXPECT_EQ(visited.size(), tour.clusters.size());
+  for (int row = 0; row < map.getRowCount(); row++) {
+    for (int col = 0; col < map.getColCount(); col++) {
+      if (!map.canOccupy(row, col)) {
+        continue;
+      }
+      const int holders = std::count_if(
+          tour.clusters.begin(), tour.clusters.end(),
+          [&](const std::array<int, 4> &block) {
+            return row >= block[0] && row <= block[2] && col >= block[1] &&
+                   col <= block[3];
+          });
+      ASSERT_EQ(holders, 1) << row << ", " << col;
+    }
+  }
+}
+
+TEST(CoverageTest, TourRepositionTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  RoutePlanner nearest(aircraft, 1.0, 20000);
+  RoutePlanner touring(aircraft, 1.0, 20000, TurnPreference::turn_LEFTFIRST,
+                       RepositionMode::reposition_TOUR);
+  const std::vector<Moves> nearestRoute = nearest.findRoute();
+  const std::vector<Moves> tourRoute = touring.findRoute();
+
+  const ReplayResult replay =
+      replayRoute(map, aircraft.getState(), tourRoute);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_EQ(replay.scannedCount, map.getTraversableCount());
+
+  // Finishing each cluster in tour order leaves fewer pockets to fly back to
+  const ReplayResult nearestReplay =
+      replayRoute(map, aircraft.getState(), nearestRoute);
+  const auto idleMoves = [](const ReplayResult &result) {
+    return std::count(result.stepGains.begin(), result.stepGains.end(), 0);
+  };
+  EXPECT_LT(idleMoves(replay), idleMoves(nearestReplay));
+  EXPECT_LT(tourRoute.size(), nearestRoute.size());
+}
+
+TEST(CoverageTest, RegionPartitionTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const int cols = map.getColCount();
+  RegionPartition partition(map, 4);
+  ASSERT_EQ(partition.getRegionCount(), 4);
+  EXPECT_LT(partition.getImbalance(), 1.2);
+
+  // Every traversable Cell is in a region, and each region is connected
+  int total = 0;
+  for (int region = 0; region < 4; region++) {
+    total += partition.getRegionSize(region);
+    int first = -1;
+    for (int cell = 0; first < 0 && cell < map.getRowCount() * cols; cell++) {
+      first = partition.getRegions()[cell] == region ? cell : -1;
+    }
+    ASSERT_GE(first, 0);
+    std::vector<bool> seen(map.getRowCount() * cols, false);
+    std::vector<int> queue = {first};
+    seen[first] = true;
+    for (std::size_t head = 0; head < queue.size(); head++) {
+      const int row = queue[head] / cols;
+      const int col = queue[head] % cols;
+      const int neighbours[4][2] = {
+          {row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+      for (const auto &next : neighbours) {
+        if (map.canOccupy(next[0], next[1]) &&
+            partition.getRegion(next[0], next[1]) == region &&
+            !seen[next[0] * cols + next[1]]) {
+          seen[next[0] * cols + next[1]] = true;
+          queue.push_back(next[0] * cols + next[1]);
+        }
+      }
+    }
+    EXPECT_EQ(static_cast<int>(queue.size()), partition.getRegionSize(region));
+  }
+  EXPECT_EQ(total, map.getTraversableCount());
+
+  // Restricting a map leaves only the region unscanned
+  GridMap restricted = map;
+  partition.restrictTo(restricted, 2);
+  EXPECT_EQ(restricted.scanAreaGain(0, 0, map.getRowCount() - 1, cols - 1),
+            partition.getRegionSize(2));
+
+  // Fixed seeds each keep their own Cell, even when two coincide
+  const AircraftState seed = makeState(0, 0, Direction::dir_EAST);
+  RegionPartition fixed(map, std::vector<AircraftState>{seed, seed});
+  EXPECT_EQ(fixed.getRegion(0, 0), 0);
+  EXPECT_GT(fixed.getRegionSize(1), 0);
+  EXPECT_LT(fixed.getImbalance(), 1.5);
+}
@@ -1,4 +1,5 @@
 #include "../src/map.h"
+#include "../src/state.h"
 #include <gtest/gtest.h>
 
 TEST(GridMapTest, ValidCSVTest) {
@@ -35,6 +36,13 @@ TEST(GridMapTest, NoCSV) {
   EXPECT_THROW(GridMap gridMap(1, "IDontExist.csv"), std::exception);
 }
 
+TEST(GridMapTest, OversizedMapTest) {
+  // Poses hold rows and columns in 16 bits, so wider maps are rejected
+  EXPECT_THROW(
+      GridMap gridMap(MAX_MAP_EXTENT + 1, "test_csv/smallTestGrid.csv"),
+      std::exception);
+}
+
 TEST(GridMapTest, CSVWithBadNumericValueTest) {
   // Create a GridMap with width 3 and expected height 1.
   GridMap gridMap(3, "test_csv/badNumericCSV.csv");
@@ -133,3 +141,32 @@ TEST(GridMapTest, floodFillTest) {
   EXPECT_FALSE(gridMap.isTraversable(11, 99));
   EXPECT_TRUE(gridMap.isTraversable(23, 34));
 }
+
+TEST(GridMapTest, gainTableTest) {
+  GridMap gridMap(50, "test_csv/mediumTestGrid.csv");
+  GridMap tracked = gridMap;
+  enableGainTable(tracked);
+
+  const auto expectTableMatchesKernel = [&tracked]() {
+    for (int row = 0; row < tracked.getRowCount(); row++) {
+      for (int col = 0; col < tracked.getColCount(); col++) {
+        for (int heading = 0; heading < 4; heading++) {
+          const std::array<int, 4> area = scanFootprint(
+              makeState(row, col, static_cast<Direction>(heading)));
+          ASSERT_EQ(tracked.tableGain(row, col, heading),
+                    tracked.scanAreaGain(area[0], area[1], area[2], area[3]));
+        }
+      }
+    }
+  };
+  expectTableMatchesKernel();
+
+  // Scans, single Cell marks and terrain edits each keep the table exact
+  EXPECT_EQ(tracked.scanArea(3, 4, 9, 20), gridMap.scanArea(3, 4, 9, 20));
+  tracked.markScanned(30, 30);
+  tracked.markScanned(30, 30);
+  tracked.markUntraversable(25, 25);
+  tracked.markUntraversable(40, 10);
+  tracked.scanArea(0, 40, 49, 49);
+  expectTableMatchesKernel();
+}
@@ -0,0 +1,212 @@
+#include "../src/cancel.h"
+#include "../src/fleet.h"
+#include "../src/planner.h"
+#include "../src/portfolio.h"
+#include "../src/replay.h"
+#include "../src/spanningtree.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A planner that never moves, for testing registration
+class IdlePlanner : public CoveragePlanner {
+protected:
+  std::vector<Moves> route(const Aircraft & /*aircraft*/,
+                           float /*searchPercentage*/,
+                           int /*moveLimit*/,
+                           const CancelToken & /*token*/) override {
+    return {};
+  }
+};
+
+} // namespace
+
+TEST(PlannerTest, RegistryTest) {
+  const std::vector<std::string> names = getPlannerNames();
+  for (const std::string name : {"greedy", "boustrophedon", "spanning_tree"}) {
+    EXPECT_NE(std::find(names.begin(), names.end(), name), names.end());
+    EXPECT_FALSE(getPlannerDescription(name).empty());
+  }
+  EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+  EXPECT_ANY_THROW(makePlanner("no_such_planner"));
+  EXPECT_ANY_THROW(getPlannerDescription("no_such_planner"));
+}
+
+TEST(PlannerTest, PlanRouteTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (const std::string &name : getPlannerNames()) {
+    const PlanResult result = planRoute(name, map, start, 0.8, 10000);
+    EXPECT_TRUE(result.valid) << name;
+    EXPECT_TRUE(result.targetMet) << name;
+    EXPECT_GE(result.coverage, 0.8) << name;
+    EXPECT_GE(result.planSeconds, 0.0) << name;
+    EXPECT_EQ(result.start, start) << name;
+    EXPECT_FALSE(result.interrupted) << name;
+  }
+
+  // A registered planner plans the same route as the class it wraps
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  SpanningTreePlanner direct(aircraft, 0.8, 10000);
+  const PlanResult result = planRoute("spanning_tree", map, start, 0.8, 10000);
+  EXPECT_EQ(result.moves, direct.findRoute());
+  EXPECT_EQ(result.scannedCount,
+            replayRoute(map, start, result.moves).scannedCount);
+}
+
+TEST(PlannerTest, MoveLimitTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (const std::string &name : getPlannerNames()) {
+    for (const int moveLimit : {1, 2, 3, 10, 57, 200}) {
+      const PlanResult result = planRoute(name, map, start, 1, moveLimit);
+      EXPECT_TRUE(result.valid) << name;
+      EXPECT_LE(static_cast<int>(result.moves.size()), moveLimit)
+          << name << " with " << moveLimit << " moves";
+    }
+  }
+}
+
+TEST(PlannerTest, RegisterPlannerTest) {
+  registerPlanner("idle", "Never moves", [] {
+    return std::unique_ptr<CoveragePlanner>(new IdlePlanner());
+  });
+  GridMap map(25, "test_csv/smallTestGrid.csv");
+  const PlanResult result =
+      planRoute("idle", map, makeState(0, 0, Direction::dir_EAST), 0.5, 100);
+  EXPECT_TRUE(result.moves.empty());
+  EXPECT_TRUE(result.valid);
+  EXPECT_FALSE(result.targetMet);
+  EXPECT_LT(result.coverage, 0.5);
+}
+
+TEST(PlannerTest, PortfolioTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  const std::vector<PortfolioEntry> entries = {
+      {"spanning_tree", Direction::dir_EAST},
+      {"boustrophedon", Direction::dir_SOUTH},
+      {"greedy_right", Direction::dir_WEST}};
+  const PortfolioResult portfolio =
+      planPortfolio(map, start, 0.8, 10000, entries,
+                    PortfolioGoal::goal_FEWESTMOVES, 2);
+  ASSERT_EQ(portfolio.results.size(), entries.size());
+  for (const PlanResult &result : portfolio.results) {
+    EXPECT_TRUE(result.valid);
+    EXPECT_TRUE(result.targetMet);
+    EXPECT_EQ(result.start, start);
+    EXPECT_LE(portfolio.getBest().moves.size(), result.moves.size());
+  }
+  // Routes start with the turns to their heading and stop at the target
+  EXPECT_EQ(portfolio.results[1].moves.front(), Moves::move_TURNRIGHT);
+  EXPECT_EQ(portfolio.results[2].moves[0], Moves::move_TURNRIGHT);
+  EXPECT_EQ(portfolio.results[2].moves[1], Moves::move_TURNRIGHT);
+  std::vector<Moves> shorter = portfolio.getBest().moves;
+  shorter.pop_back();
+  EXPECT_FALSE(evaluateRoute(map, start, shorter, 0.8).targetMet);
+
+  // With a tight budget, the most coverage wins
+  const PortfolioResult limited =
+      planPortfolio(map, start, 1.0, 100, entries,
+                    PortfolioGoal::goal_MOSTCOVERAGE, 2);
+  for (const PlanResult &result : limited.results) {
+    EXPECT_LE(result.moves.size(), 100u);
+    EXPECT_LE(result.scannedCount, limited.getBest().scannedCount);
+  }
+
+  EXPECT_ANY_THROW(planPortfolio(map, start, 0.8, 100, {}));
+}
+
+TEST(PlannerTest, FleetTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const std::vector<AircraftState> starts = {
+      makeState(0, 0, Direction::dir_EAST),
+      makeState(map.getRowCount() - 1, map.getColCount() - 1,
+                Direction::dir_WEST)};
+  Aircraft second(starts[1].row, starts[1].dir, starts[1].col, map);
+
+  const FleetResult fleet = planFleet(map, starts, 0.8, 10000);
+  ASSERT_EQ(fleet.routes.size(), 2u);
+  EXPECT_TRUE(fleet.targetMet);
+  EXPECT_GE(fleet.coverage, 0.8);
+  for (const PlanResult &route : fleet.routes) {
+    EXPECT_TRUE(route.valid);
+    EXPECT_TRUE(route.targetMet);
+    EXPECT_LE(static_cast<int>(route.moves.size()), fleet.missionLength);
+  }
+  EXPECT_EQ(fleet.routes[1].start, second.getState());
+
+  // Each aircraft's region holds its start
+  EXPECT_EQ(fleet.regions[0], 0);
+  EXPECT_EQ(fleet.regions[second.getCurRow() * map.getColCount() +
+                          second.getCurCol()],
+            1);
+
+  // Two aircraft finish sooner than one
+  const PlanResult single =
+      planRoute("spanning_tree", map, starts[0], 0.8, 10000);
+  EXPECT_LT(fleet.missionLength, static_cast<int>(single.moves.size()));
+}
+
+TEST(PlannerTest, FleetSmallShareTest) {
+  // Eight aircraft at a small target each have less than 1% of the map to
+  // scan, and stop once they have scanned it
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  std::vector<AircraftState> starts;
+  for (int index = 0; index < 8; index++) {
+    starts.push_back(makeState(index * (map.getRowCount() - 1) / 7,
+                               index % 2 == 0 ? 0 : map.getColCount() - 1,
+                               Direction::dir_NORTH));
+  }
+  const FleetResult fleet = planFleet(map, starts, 0.05, 10000);
+  EXPECT_TRUE(fleet.targetMet);
+  EXPECT_GE(fleet.coverage, 0.05);
+  EXPECT_LT(fleet.coverage, 0.06);
+  for (const PlanResult &route : fleet.routes) {
+    EXPECT_TRUE(route.valid);
+    EXPECT_TRUE(route.targetMet);
+  }
+}
+
+TEST(PlannerTest, CancelTest) {
+  // Copies share one flag
+  const CancelToken token;
+  const CancelToken copy = token;
+  EXPECT_FALSE(copy.stopRequested());
+  token.cancel();
+  EXPECT_TRUE(copy.isCancelled());
+  EXPECT_TRUE(copy.stopRequested());
+  EXPECT_TRUE(CancelToken(0.0).stopRequested());
+  EXPECT_FALSE(CancelToken(3600.0).stopRequested());
+
+  // A stopped planner returns the legal route flown so far
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (const CancelToken &stop : {copy, CancelToken(0.0)}) {
+    for (const std::string &name : getPlannerNames()) {
+      const PlanResult result = planRoute(name, map, start, 0.8, 10000, stop);
+      EXPECT_TRUE(result.valid) << name;
+      EXPECT_FALSE(result.targetMet) << name;
+      EXPECT_TRUE(result.interrupted) << name;
+      EXPECT_TRUE(result.moves.empty()) << name;
+    }
+  }
+
+  // Portfolios and fleets pass the token on
+  const PortfolioResult portfolio =
+      planPortfolio(map, start, 0.8, 10000, defaultPortfolio(),
+                    PortfolioGoal::goal_FEWESTMOVES, 0, token);
+  for (const PlanResult &result : portfolio.results) {
+    EXPECT_TRUE(result.valid);
+    EXPECT_TRUE(result.interrupted);
+  }
+  const FleetResult fleet =
+      planFleet(map, {start, makeState(99, 99, Direction::dir_WEST)}, 0.8,
+                10000, "spanning_tree", 0, token);
+  EXPECT_TRUE(fleet.interrupted);
+  EXPECT_FALSE(fleet.targetMet);
+}
@@ -0,0 +1,175 @@
+#include "../src/cancel.h"
+#include "../src/optimizer.h"
+#include "../src/planner.h"
+#include "../src/replay.h"
+#include "../src/router1.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The Cells a route scans after its start pose
+std::set<std::pair<int, int>> routeCells(const GridMap &map,
+                                         const AircraftState &start,
+                                         const std::vector<Moves> &route) {
+  std::set<std::pair<int, int>> cells;
+  for (const auto &step : replayRoute(map, start, route, true).scannedCells) {
+    cells.insert(step.begin(), step.end());
+  }
+  return cells;
+}
+
+} // namespace
+
+TEST(ReplayTest, PlannedRouteTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  RoutePlanner router(aircraft, 0.5, 4000);
+  const std::vector<Moves> route = router.findRoute();
+
+  const ReplayResult replay = replayRoute(map, aircraft.getState(), route);
+  EXPECT_TRUE(replay.valid);
+  EXPECT_EQ(replay.firstIllegalMove, -1);
+  EXPECT_EQ(replay.movesFlown, static_cast<int>(route.size()));
+  EXPECT_GE(replay.coverage, 0.5);
+
+  // The map itself is left unscanned
+  for (int row = 0; row < map.getRowCount(); row++) {
+    for (int col = 0; col < map.getColCount(); col++) {
+      ASSERT_FALSE(map.isScanned(row, col));
+    }
+  }
+}
+
+TEST(ReplayTest, IllegalMoveTest) {
+  GridMap map(4, "test_csv/manuverableCSV.csv");
+  const std::vector<Moves> route = {
+      Moves::move_FORWARD,   Moves::move_FORWARD, Moves::move_FORWARD,
+      Moves::move_TURNRIGHT, Moves::move_FORWARD, Moves::move_FORWARD,
+      Moves::move_FORWARD};
+
+  const ReplayResult replay = replayRoute(
+      map, makeState(0, 0, Direction::dir_EAST), route, true);
+  EXPECT_FALSE(replay.valid);
+  EXPECT_EQ(replay.firstIllegalMove, 5);
+  EXPECT_EQ(replay.movesFlown, 5);
+  EXPECT_EQ(replay.finalState, makeState(1, 3, Direction::dir_SOUTH));
+  ASSERT_EQ(replay.scannedCells.size(), 5u);
+
+  int recorded = 0;
+  for (const auto &cells : replay.scannedCells) {
+    recorded += static_cast<int>(cells.size());
+  }
+  EXPECT_EQ(recorded + replay.initialGain, replay.scannedCount);
+}
+
+TEST(ReplayTest, ParallelReplayTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  std::vector<AircraftState> starts;
+  std::vector<std::vector<Moves>> routes;
+  for (int i = 0; i < 8; i++) {
+    Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+    RoutePlanner router(aircraft, 0.005f * (i + 1), 4000);
+    starts.push_back(aircraft.getState());
+    routes.push_back(router.findRoute());
+  }
+
+  const std::vector<ReplayResult> results =
+      replayRoutes(map, starts, routes, 4);
+  ASSERT_EQ(results.size(), routes.size());
+  for (std::size_t i = 0; i < routes.size(); i++) {
+    const ReplayResult expected = replayRoute(map, starts[i], routes[i]);
+    EXPECT_EQ(results[i].valid, expected.valid);
+    EXPECT_EQ(results[i].scannedCount, expected.scannedCount);
+    EXPECT_EQ(results[i].stepGains, expected.stepGains);
+    EXPECT_EQ(results[i].finalState, expected.finalState);
+  }
+}
+
+TEST(ReplayTest, OptimizeRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (const std::string &name : getPlannerNames()) {
+    const PlanResult result = planRoute(name, map, start, 0.8, 10000);
+    const std::vector<Moves> optimized =
+        optimizeRoute(map, result.start, result.moves);
+    const ReplayResult replay = replayRoute(map, result.start, optimized);
+    EXPECT_TRUE(replay.valid) << name;
+    EXPECT_LE(optimized.size(), result.moves.size()) << name;
+
+    // Every Cell the planned route scans is still scanned
+    const std::set<std::pair<int, int>> before =
+        routeCells(map, result.start, result.moves);
+    const std::set<std::pair<int, int>> after =
+        routeCells(map, result.start, optimized);
+    EXPECT_TRUE(std::includes(after.begin(), after.end(), before.begin(),
+                              before.end()))
+        << name;
+  }
+
+  // Sweeps leave repositioning legs that are longer than they need to be
+  const PlanResult sweep = planRoute("boustrophedon", map, start, 0.8, 10000);
+  EXPECT_LT(optimizeRoute(map, sweep.start, sweep.moves).size(),
+            sweep.moves.size());
+}
+
+TEST(ReplayTest, OptimizeWasteTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  RoutePlanner router(aircraft, 0.5, 4000);
+  const std::vector<Moves> route = router.findRoute();
+
+  // A second spin in place scans nothing the first did not, both halfway
+  // through the route and after its end
+  const std::vector<Moves> spin(4, Moves::move_TURNLEFT);
+  std::vector<Moves> wasteful = route;
+  for (int copy = 0; copy < 2; copy++) {
+    wasteful.insert(wasteful.begin() + route.size() / 2, spin.begin(),
+                    spin.end());
+    wasteful.insert(wasteful.end(), spin.begin(), spin.end());
+  }
+  const std::vector<Moves> optimized =
+      optimizeRoute(map, aircraft.getState(), wasteful);
+  EXPECT_LE(optimized.size(), route.size() + 2 * spin.size());
+  EXPECT_GE(replayRoute(map, aircraft.getState(), optimized).scannedCount,
+            replayRoute(map, aircraft.getState(), wasteful).scannedCount);
+
+  // Illegal routes are left alone
+  const std::vector<Moves> illegal = {Moves::move_TURNLEFT,
+                                      Moves::move_FORWARD};
+  EXPECT_EQ(optimizeRoute(map, aircraft.getState(), illegal), illegal);
+}
+
+TEST(ReplayTest, ImproveRouteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  Aircraft aircraft(0, Direction::dir_EAST, 0, map);
+  RoutePlanner router(aircraft, 0.8, 10000);
+  const std::vector<Moves> route = router.findRoute();
+
+  const ImproveResult improved =
+      improveRoute(map, aircraft.getState(), route, 0.8, 20, 1);
+  EXPECT_EQ(improved.rounds, 20);
+  EXPECT_GT(improved.windowsKept, 0);
+  EXPECT_FALSE(improved.interrupted);
+  EXPECT_LT(improved.moves.size(), route.size());
+  const PlanResult result =
+      evaluateRoute(map, aircraft.getState(), improved.moves, 0.8);
+  EXPECT_TRUE(result.valid);
+  EXPECT_TRUE(result.targetMet);
+
+  // Windows are re-planned the same way however many threads share them
+  const ImproveResult parallel =
+      improveRoute(map, aircraft.getState(), route, 0.8, 20, 3);
+  EXPECT_EQ(parallel.moves, improved.moves);
+
+  // A deadline that has already passed keeps the route as it was
+  const ImproveResult late = improveRoute(map, aircraft.getState(), route,
+                                          0.8, 20, 1, 1, CancelToken(0.0));
+  EXPECT_TRUE(late.interrupted);
+  EXPECT_EQ(late.rounds, 0);
+  EXPECT_EQ(late.moves, route);
+}
@@ -0,0 +1,325 @@
+#include "../src/dstarlite.h"
+#include "../src/pathfinder.h"
+#include "../src/replanner.h"
+#include "../src/replay.h"
+#include "../src/search.h"
+#include "../src/traps.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(SearchTest, ShortestPathTest) {
+  GridMap map(4, "test_csv/manuverableCSV.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+
+  const std::vector<Moves> expected = {
+      Moves::move_FORWARD, Moves::move_FORWARD, Moves::move_FORWARD,
+      Moves::move_TURNRIGHT, Moves::move_FORWARD};
+  EXPECT_EQ(shortestPath(map, start, 1, 3), expected);
+  EXPECT_EQ(shortestPath(map, start, 3, 0).size(), 4u);
+
+  // Already there, and unreachable
+  EXPECT_TRUE(shortestPath(map, start, 0, 0).empty());
+  EXPECT_TRUE(shortestPath(map, start, 2, 3).empty());
+}
+
+TEST(SearchTest, StateIdTest) {
+  GridMap map(50, "test_csv/mediumTestGrid.csv");
+  for (int id = 0; id < stateCount(map); id += 7) {
+    EXPECT_EQ(stateId(map, stateFromId(map, id)), id);
+  }
+}
+
+TEST(SearchTest, PathReachesTargetTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (int row = 0; row < map.getRowCount(); row += 9) {
+    for (int col = 0; col < map.getColCount(); col += 11) {
+      if (!map.canOccupy(row, col)) {
+        continue;
+      }
+      const std::vector<Moves> path = shortestPath(map, start, row, col);
+      const ReplayResult replay = replayRoute(map, start, path);
+      ASSERT_TRUE(replay.valid);
+      EXPECT_EQ(replay.finalState.row, row);
+      EXPECT_EQ(replay.finalState.col, col);
+      // No path can beat the manhattan distance
+      EXPECT_GE(static_cast<int>(path.size()), row + col);
+    }
+  }
+}
+
+TEST(SearchTest, WorkspaceReuseTest) {
+  SearchWorkspace workspace;
+  workspace.begin(10);
+  workspace.push(3, 2);
+  EXPECT_TRUE(workspace.isVisited(3));
+  EXPECT_EQ(workspace.getParent(3), 2);
+  EXPECT_EQ(workspace.pop(), 3);
+  EXPECT_TRUE(workspace.frontierEmpty());
+
+  // A new search forgets the old one without clearing, and may grow
+  workspace.begin(100);
+  EXPECT_FALSE(workspace.isVisited(3));
+  EXPECT_FALSE(workspace.isVisited(99));
+  EXPECT_EQ(workspace.getPushedCount(), 0);
+
+  // Searches sharing a workspace match searches with their own
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (int row = 5; row < map.getRowCount(); row += 17) {
+    for (int col = 3; col < map.getColCount(); col += 13) {
+      EXPECT_EQ(shortestPath(map, start, row, col, workspace),
+                shortestPath(map, start, row, col));
+    }
+  }
+}
+
+TEST(SearchTest, PathToNewScanTest) {
+  GridMap map(25, "test_csv/smallTestGrid.csv");
+  const AircraftState start = makeState(9, 4, Direction::dir_SOUTH);
+  SearchWorkspace workspace;
+
+  // Leave a single unscanned Cell far from the start
+  int targetRow = -1;
+  int targetCol = -1;
+  for (int row = 0; row < map.getRowCount(); row++) {
+    for (int col = 0; col < map.getColCount(); col++) {
+      if (map.isTraversable(row, col)) {
+        targetRow = row;
+        targetCol = col;
+      }
+    }
+  }
+  for (int row = 0; row < map.getRowCount(); row++) {
+    for (int col = 0; col < map.getColCount(); col++) {
+      if (map.isTraversable(row, col) &&
+          (row != targetRow || col != targetCol)) {
+        map.markScanned(row, col);
+      }
+    }
+  }
+
+  const std::vector<Moves> path = pathToNewScan(map, start, workspace);
+  ASSERT_FALSE(path.empty());
+  const ReplayResult replay = replayRoute(map, start, path);
+  ASSERT_TRUE(replay.valid);
+  EXPECT_EQ(replay.scannedCount, 1);
+  EXPECT_EQ(replay.stepGains.back(), 1);
+
+  // Once everything is scanned there is nowhere to go
+  map.markScanned(targetRow, targetCol);
+  EXPECT_TRUE(pathToNewScan(map, start, workspace).empty());
+}
+
+TEST(SearchTest, LandmarkPathTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const LandmarkTable landmarks(map, 6);
+  EXPECT_EQ(landmarks.getLandmarkCount(), 6);
+
+  SearchWorkspace workspace;
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (int row = 2; row < map.getRowCount(); row += 7) {
+    for (int col = 1; col < map.getColCount(); col += 9) {
+      if (!map.canOccupy(row, col)) {
+        continue;
+      }
+      const std::vector<Moves> exact = shortestPath(map, start, row, col);
+      const std::vector<Moves> guided =
+          shortestPath(map, start, row, col, workspace, landmarks);
+      // Equally short, and the bound never overestimates
+      ASSERT_EQ(guided.size(), exact.size());
+      EXPECT_LE(landmarks.lowerBound(0, 0, row, col),
+                static_cast<int>(exact.size()));
+      const ReplayResult replay = replayRoute(map, start, guided);
+      ASSERT_TRUE(replay.valid);
+      EXPECT_EQ(replay.finalState.row, row);
+      EXPECT_EQ(replay.finalState.col, col);
+    }
+  }
+}
+
+TEST(SearchTest, PathEngineTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  PathFinder exact(map, PathEngine::engine_BFS);
+  PathFinder roadmap(map, PathEngine::engine_ROADMAP);
+
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  int exactTotal = 0;
+  int roadmapTotal = 0;
+  for (int row = 1; row < map.getRowCount(); row += 6) {
+    for (int col = 4; col < map.getColCount(); col += 8) {
+      if (!map.canOccupy(row, col)) {
+        continue;
+      }
+      const std::vector<Moves> path = roadmap.findPath(start, row, col);
+      const ReplayResult replay = replayRoute(map, start, path);
+      ASSERT_TRUE(replay.valid);
+      EXPECT_EQ(replay.finalState.row, row);
+      EXPECT_EQ(replay.finalState.col, col);
+      exactTotal += static_cast<int>(exact.findPath(start, row, col).size());
+      roadmapTotal += static_cast<int>(path.size());
+    }
+  }
+  // Roadmap paths are near-optimal
+  EXPECT_GE(roadmapTotal, exactTotal);
+  EXPECT_LE(roadmapTotal, exactTotal * 11 / 10);
+}
+
+TEST(SearchTest, StoppedRoadmapTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  PathFinder roadmap(map, PathEngine::engine_ROADMAP);
+  CancelToken token;
+  token.cancel();
+  roadmap.setCancelToken(token);
+
+  // Searches give up part way through, so a path is either empty or legal
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  for (int row = 1; row < map.getRowCount(); row += 6) {
+    for (int col = 4; col < map.getColCount(); col += 8) {
+      if (!map.canOccupy(row, col)) {
+        continue;
+      }
+      const std::vector<Moves> path = roadmap.findPath(start, row, col);
+      if (path.empty()) {
+        continue;
+      }
+      const ReplayResult replay = replayRoute(map, start, path);
+      ASSERT_TRUE(replay.valid);
+      EXPECT_EQ(replay.finalState.row, row);
+      EXPECT_EQ(replay.finalState.col, col);
+    }
+  }
+}
+
+TEST(SearchTest, JumpPointPathTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  PathFinder exact(map, PathEngine::engine_BFS);
+  PathFinder jump(map, PathEngine::engine_JUMP);
+  EXPECT_EQ(jump.getEngine(), PathEngine::engine_JUMP);
+
+  for (int dir = 0; dir < 4; dir++) {
+    const AircraftState start = makeState(0, 0, static_cast<Direction>(dir));
+    for (int row = 3; row < map.getRowCount(); row += 5) {
+      for (int col = dir; col < map.getColCount(); col += 7) {
+        if (!map.canOccupy(row, col)) {
+          continue;
+        }
+        // Jumping skips poses but never lengthens the path
+        const std::vector<Moves> path = jump.findPath(start, row, col);
+        ASSERT_EQ(path.size(), exact.findPath(start, row, col).size());
+        const ReplayResult replay = replayRoute(map, start, path);
+        ASSERT_TRUE(replay.valid);
+        EXPECT_EQ(replay.finalState.row, row);
+        EXPECT_EQ(replay.finalState.col, col);
+      }
+    }
+  }
+}
+
+TEST(SearchTest, TrapTableTest) {
+  GridMap map(4, "test_csv/manuverableCSV.csv");
+  const TrapTable traps(map);
+
+  // Open ground: straight on or a right turn into the map
+  const AircraftState open = makeState(0, 0, Direction::dir_EAST);
+  EXPECT_EQ(traps.getSuccessors(open), succ_FORWARD | succ_TURNRIGHT);
+  EXPECT_TRUE(traps.isEscapable(open));
+
+  // The end of the dead-end column on the right cannot be flown out of
+  const AircraftState deadEnd = makeState(1, 3, Direction::dir_SOUTH);
+  EXPECT_EQ(traps.getSuccessors(deadEnd), 0);
+  EXPECT_FALSE(traps.isEscapable(deadEnd));
+  // Above it, facing east, the only way on leads into it
+  const AircraftState mouth = makeState(0, 3, Direction::dir_EAST);
+  EXPECT_TRUE(traps.hasSuccessor(mouth, succ_TURNRIGHT));
+  EXPECT_FALSE(traps.hasSuccessor(mouth, succ_FORWARD));
+  EXPECT_FALSE(traps.isEscapable(mouth));
+  // Facing south it can still turn back west
+  EXPECT_TRUE(traps.isEscapable(makeState(0, 3, Direction::dir_SOUTH)));
+
+  EXPECT_FALSE(traps.isEscapable(makeState(2, 2, Direction::dir_NORTH)));
+  EXPECT_GE(traps.getTrappedCount(), 3);
+}
+
+TEST(SearchTest, DStarLiteTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const int goalRow = 95;
+  const int goalCol = 90;
+  ASSERT_TRUE(map.canOccupy(goalRow, goalCol));
+  DStarLite paths(map, goalRow, goalCol);
+
+  // Paths are as short as a fresh search's while the start moves along
+  AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  std::vector<Moves> path = paths.findPath(start);
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.size(), shortestPath(map, start, goalRow, goalCol).size());
+  for (int index = 0; index < 20; index++) {
+    start = applyMove(start, path[index]);
+  }
+  path = paths.findPath(start);
+  EXPECT_EQ(path.size(), shortestPath(map, start, goalRow, goalCol).size());
+
+  // Block Cells on the current path; the repair stays exact and valid
+  const long long firstSearch = paths.getExpandedCount();
+  for (int blockedCount = 0; blockedCount < 5; blockedCount++) {
+    AircraftState ahead = start;
+    for (std::size_t index = 0; index < path.size() / 2; index++) {
+      ahead = applyMove(ahead, path[index]);
+    }
+    map.markUntraversable(ahead.row, ahead.col);
+    paths.cellBlocked(ahead.row, ahead.col);
+    path = paths.findPath(start);
+    ASSERT_FALSE(path.empty());
+    const ReplayResult replay = replayRoute(map, start, path);
+    EXPECT_TRUE(replay.valid);
+    EXPECT_EQ(replay.finalState.row, goalRow);
+    EXPECT_EQ(replay.finalState.col, goalCol);
+    EXPECT_EQ(path.size(), shortestPath(map, start, goalRow, goalCol).size());
+  }
+  // Repairs touch far fewer poses than the first search did
+  EXPECT_LT(paths.getExpandedCount() - firstSearch, firstSearch);
+
+  // Already there, and walled off
+  EXPECT_TRUE(paths.findPath(makeState(goalRow, goalCol, start.dir)).empty());
+  map.markUntraversable(goalRow, goalCol);
+  paths.cellBlocked(goalRow, goalCol);
+  EXPECT_TRUE(paths.findPath(start).empty());
+}
+
+TEST(SearchTest, MissionReplannerTest) {
+  GridMap map(100, "test_csv/bigTestGrid.csv");
+  const AircraftState start = makeState(0, 0, Direction::dir_EAST);
+  const std::vector<Moves> route = shortestPath(map, start, 95, 90);
+  MissionReplanner mission(map, start, route);
+  const AircraftState end = replayRoute(map, start, route).finalState;
+
+  // An obstacle off the route changes nothing
+  EXPECT_FALSE(mission.markUntraversable(0, 99));
+  EXPECT_EQ(mission.getRemainingRoute(), route);
+
+  // Obstacles ahead are flown around, and the route still ends as planned
+  mission.advance(10);
+  for (int obstacle = 0; obstacle < 3; obstacle++) {
+    const std::vector<Moves> &remaining = mission.getRemainingRoute();
+    AircraftState ahead = mission.getState();
+    for (std::size_t index = 0; index < remaining.size() / 3; index++) {
+      ahead = applyMove(ahead, remaining[index]);
+    }
+    EXPECT_TRUE(mission.markUntraversable(ahead.row, ahead.col));
+    const ReplayResult replay = replayRoute(
+        mission.getMap(), mission.getState(), mission.getRemainingRoute());
+    EXPECT_TRUE(replay.valid);
+    EXPECT_EQ(replay.finalState, end);
+    mission.advance(5);
+  }
+
+  // Repositioning paths see the obstacles too
+  const std::vector<Moves> leg = mission.pathTo(50, 50);
+  const ReplayResult replay =
+      replayRoute(mission.getMap(), mission.getState(), leg);
+  EXPECT_TRUE(replay.valid);
+  EXPECT_EQ(replay.finalState.row, 50);
+  EXPECT_EQ(replay.finalState.col, 50);
+  EXPECT_ANY_THROW(mission.markUntraversable(mission.getState().row,
+                                             mission.getState().col));
+}
@@ -335,51 +335,29 @@ class View(ttk.Frame):
         cell_height = canvas_height // num_rows if num_rows else 20
         cell_size = min(cell_width, cell_height)
 
-        # aircraft initial position
-        aircraft_row: int = aircraft.getCurRow()
-        aircraft_col: int = aircraft.getCurCol()
+        # fly the route in the backend, which applies the same motion and
+        # scanning rules as the router
+        replay = backend_binding.replayRoute(
+            grid_map, aircraft.getState(), route, True
+        )
 
-        start_row: int = aircraft_row
-        start_col: int = aircraft_col
+        start_row: int = aircraft.getCurRow()
+        start_col: int = aircraft.getCurCol()
 
-        direction: str = aircraft.getDir()
+        aircraft_row: int = start_row
+        aircraft_col: int = start_col
 
-        moves: list[tuple[int, int]] = []
-        for move in route:
-            moves.append((aircraft_row, aircraft_col))
+        moves: set[tuple[int, int]] = set()
+        for state, scanned_cells in zip(replay.states, replay.scannedCells):
+            moves.add((aircraft_row, aircraft_col))
 
             x1 = aircraft_col * cell_size
             y1 = aircraft_row * cell_size
             x2 = x1 + cell_size
             y2 = y1 + cell_size
 
-            if move == backend_binding.Moves.FORWARD:
-                if direction == backend_binding.Direction.NORTH:
-                    aircraft_row -= 1
-                elif direction == backend_binding.Direction.EAST:
-                    aircraft_col += 1
-                elif direction == backend_binding.Direction.SOUTH:
-                    aircraft_row += 1
-                elif direction == backend_binding.Direction.WEST:
-                    aircraft_col -= 1
-            elif move == backend_binding.Moves.TURNLEFT:
-                if direction == backend_binding.Direction.NORTH:
-                    direction = backend_binding.Direction.WEST
-                elif direction == backend_binding.Direction.EAST:
-                    direction = backend_binding.Direction.NORTH
-                elif direction == backend_binding.Direction.SOUTH:
-                    direction = backend_binding.Direction.EAST
-                elif direction == backend_binding.Direction.WEST:
-                    direction = backend_binding.Direction.SOUTH
-            elif move == backend_binding.Moves.TURNRIGHT:
-                if direction == backend_binding.Direction.NORTH:
-                    direction = backend_binding.Direction.EAST
-                elif direction == backend_binding.Direction.EAST:
-                    direction = backend_binding.Direction.SOUTH
-                elif direction == backend_binding.Direction.SOUTH:
-                    direction = backend_binding.Direction.WEST
-                elif direction == backend_binding.Direction.WEST:
-                    direction = backend_binding.Direction.NORTH
+            aircraft_row = state.row
+            aircraft_col = state.col
 
             color: str = "red"
 
@@ -391,37 +369,16 @@ class View(ttk.Frame):
                 x1, y1, x2, y2, fill=color, outline="gray"
             )  # Draw the grid cell
 
-            row_scanned_range: list[int] | range = []
-            col_scanned_range: list[int] | range = []
-
-            if direction == backend_binding.Direction.NORTH:
-                row_scanned_range = range(aircraft_row - 2, aircraft_row)
-                col_scanned_range = range(aircraft_col - 1, aircraft_col + 2)
-            elif direction == backend_binding.Direction.SOUTH:
-                row_scanned_range = range(aircraft_row + 1, aircraft_row + 3)
-                col_scanned_range = range(aircraft_col - 1, aircraft_col + 2)
-            elif direction == backend_binding.Direction.EAST:
-                row_scanned_range = range(aircraft_row - 1, aircraft_row + 2)
-                col_scanned_range = range(aircraft_col + 1, aircraft_col + 3)
-            elif direction == backend_binding.Direction.WEST:
-                row_scanned_range = range(aircraft_row - 1, aircraft_row + 2)
-                col_scanned_range = range(aircraft_col - 2, aircraft_col)
-
-            for row in row_scanned_range:
-                for col in col_scanned_range:
-                    if (
-                        grid_map.isWithinBounds(row, col)
-                        and grid_map.isTraversable(row, col)
-                        and ((row, col) not in moves)
-                    ):
-                        x1 = col * cell_size
-                        y1 = row * cell_size
-                        x2 = x1 + cell_size
-                        y2 = y1 + cell_size
-
-                        self.canvas.create_rectangle(
-                            x1, y1, x2, y2, fill="yellow", outline="grey"
-                        )
+            for row, col in scanned_cells:
+                if (row, col) not in moves:
+                    x1 = col * cell_size
+                    y1 = row * cell_size
+                    x2 = x1 + cell_size
+                    y2 = y1 + cell_size
+
+                    self.canvas.create_rectangle(
+                        x1, y1, x2, y2, fill="yellow", outline="grey"
+                    )
 
             if animate:
                 self.canvas.update()